@@ -20,6 +20,16 @@ if [ "$PONGBAT_INSTALL_DIR" != "" ]; then
 	echo "Install path: $PONGBAT_INSTALL_DIR"
 fi
 
+# Setup physics mode; set the env-var PONGBAT_FIXED_POINT=1 to simulate with
+# fixed-point math (see PHYSICS_FIXED_POINT, in src/pongbat.cpp)
+PONGBAT_DEFINES=""
+if [ "$PONGBAT_FIXED_POINT" = "1" ]; then
+	PONGBAT_DEFINES="$PONGBAT_DEFINES -DPHYSICS_FIXED_POINT=1"
+	echo "Physics: fixed-point"
+else
+	echo "Physics: floating-point"
+fi
+
 if ! type -p scp > /dev/null; then
 	echo "Warning: Can't find 'scp'.  Installation to remote directories will be disabled"
 	CP=cp
@@ -47,7 +57,7 @@ rm -rf pongbat* || die "Couldn't clean old files"
 
 # Rebuild
 echo "Building..."
-emcc src/pongbat.cpp -s USE_SDL=2 -O3 -std=c++11 \
+emcc src/pongbat.cpp -s USE_SDL=2 -O3 -std=c++11 $PONGBAT_DEFINES \
 	-o "$BUILD_DIR/pongbat.html" \
 	--preload-file "Data/Fonts/HussarPrint/HussarPrintA.ttf" \
 	--preload-file "Data/Images/BallBlue.png" \
@@ -27,8 +27,18 @@
 #include <unistd.h>         // for chdir()
 #endif
 
-#include <ctime>            // for time(), which is passed into srand()
-#include <cstdlib>          // for rand(), srand()
+#ifndef TEXT_BLEND_NEON
+#define TEXT_BLEND_NEON 0   // 1 to blend glyphs with NEON, on ARM (not yet verified on hardware; set via -DTEXT_BLEND_NEON=1)
+#endif
+
+#if __SSE2__                // SIMD intrinsics, used by TextBlendRow()
+#include <emmintrin.h>
+#elif __ARM_NEON && TEXT_BLEND_NEON
+#include <arm_neon.h>
+#endif
+
+#include <ctime>            // for time(), which is used as a default random-number seed
+#include <cstdlib>          // for exit()
 
 
 //   
@@ -81,8 +91,6 @@ static ImageID ImageNext = 1;
 static ImageID ImageIDBallBlue;
 static ImageID ImageIDBallNoPlayer;
 static ImageID ImageIDBallRed;
-static ImageID ImageIDPaddleBlue;
-static ImageID ImageIDPaddleRed;
 static ImageID ImageIDPaddleBlueTemplate;
 static ImageID ImageIDPaddleRedTemplate;
 static ImageID ImageIDBackgroundTile;
@@ -174,6 +182,27 @@ static uint32_t ImageGetAlphaUnshifted(SDL_Surface * image, uint16_t x, uint16_t
     return ((uint32_t *)image->pixels)[x + (y * image->w)] & ImageAMask;
 }
 
+// ImageGetRowMasks -- computes 1-bit-per-pixel masks for each row of an image, up to
+//   32 pixels wide.  Bit 'x' of a row's mask gets set if that pixel's alpha is
+//   at least 'minAlpha'.  Collision tests use these, rather than pixels.
+static SDL_bool ImageGetRowMasks(ImageID id, uint8_t minAlpha, uint32_t * outRows, uint16_t numRows)
+{
+    SDL_Surface * image = Images[id];
+    if ( ! image || image->w > 32 || image->h != numRows) {
+        SDL_Log("%s, image %u can't be made into %u row-masks", __FUNCTION__, (unsigned)id, (unsigned)numRows);
+        return SDL_FALSE;
+    }
+    for (uint16_t y = 0; y < numRows; ++y) {
+        outRows[y] = 0;
+        for (uint16_t x = 0; x < image->w; ++x) {
+            if ((ImageGetAlphaUnshifted(image, x, y) >> image->format->Ashift) >= minAlpha) {
+                outRows[y] |= (1u << x);
+            }
+        }
+    }
+    return SDL_TRUE;
+}
+
 
 //   
 //    #   #          #     #     
@@ -190,18 +219,278 @@ int MathRound(float x)
     return (x + 0.5f);
 }
 
-// MathRandRangeF -- get random float in inclusive-range; granularity limited to RAND_MAX
-float MathRandRangeF(float a, float b)
+#ifndef PHYSICS_FIXED_POINT
+#define PHYSICS_FIXED_POINT 0   // 1 to simulate with 16.16 fixed-point numbers, rather than floats (set via -DPHYSICS_FIXED_POINT=1)
+#endif
+
+#if PHYSICS_FIXED_POINT
+// Fixed -- 16.16 fixed-point number.  With PHYSICS_FIXED_POINT set, physics
+//   uses these in place of floats, so that every platform and compiler (native,
+//   Emscripten, with or without FMA, etc.) simulates matches bit-for-bit
+//   identically, and lockstep peers only ever need to exchange input.
+//   Arithmetic saturates, rather than wrapping, on overflow.
+struct Fixed {
+    int32_t raw;
+    
+    Fixed() = default;
+    constexpr Fixed(int x) : raw(x * 65536) {}
+    constexpr Fixed(double x) : raw((int32_t)((x * 65536.0) + ((x >= 0.0) ? 0.5 : -0.5))) {}
+    
+    static Fixed FromRaw(int64_t x) {
+        Fixed result;
+        result.raw = (int32_t)((x > INT32_MAX) ? INT32_MAX : ((x < INT32_MIN) ? INT32_MIN : x));
+        return result;
+    }
+    
+    Fixed operator-() const { return FromRaw(-(int64_t)raw); }
+    Fixed & operator+=(Fixed b) { return (*this = FromRaw((int64_t)raw + b.raw)); }
+    Fixed & operator-=(Fixed b) { return (*this = FromRaw((int64_t)raw - b.raw)); }
+    Fixed & operator*=(Fixed b) { return (*this = FromRaw(((int64_t)raw * b.raw) >> 16)); }
+    Fixed & operator/=(Fixed b) {
+        if (b.raw == 0) {
+            return (*this = FromRaw((raw < 0) ? INT32_MIN : INT32_MAX));
+        }
+        return (*this = FromRaw(((int64_t)raw * 65536) / b.raw));
+    }
+};
+inline Fixed operator+(Fixed a, Fixed b) { return a += b; }
+inline Fixed operator-(Fixed a, Fixed b) { return a -= b; }
+inline Fixed operator*(Fixed a, Fixed b) { return a *= b; }
+inline Fixed operator/(Fixed a, Fixed b) { return a /= b; }
+inline bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+inline bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+inline bool operator<(Fixed a, Fixed b) { return a.raw < b.raw; }
+inline bool operator>(Fixed a, Fixed b) { return a.raw > b.raw; }
+inline bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+inline bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+
+// MathRound -- fixed-point-to-int rounding
+int MathRound(Fixed x)
+{
+    return (int)(((int64_t)x.raw + 0x8000) >> 16);
+}
+
+typedef Fixed Real;     // number type for physics: positions, velocities, etc.
+
+// RealToFloat -- converts a physics number to a float, for drawing
+float RealToFloat(Real x)
+{
+    return (float)x.raw / 65536.f;
+}
+
+// RealSqrt -- square root, via integer math; 0 for negative numbers
+Real RealSqrt(Real x)
+{
+    if (x.raw <= 0) {
+        return Real(0);
+    }
+    uint64_t n = (uint64_t)x.raw << 16;
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return Fixed::FromRaw((int64_t)root);
+}
+#else
+typedef float Real;     // number type for physics: positions, velocities, etc.
+
+// RealToFloat -- converts a physics number to a float, for drawing
+float RealToFloat(Real x)
+{
+    return x;
+}
+
+// RealSqrt -- square root
+Real RealSqrt(Real x)
+{
+    return SDL_sqrtf(x);
+}
+#endif
+
+// Rand -- small, fast, seedable random number generator (xoshiro128**)
+//   Each match keeps its own, so that matches can run on separate threads, and
+//   so that a given seed always reproduces the same match.
+struct Rand {
+    uint32_t s[4];
+    
+    // Seed -- [re]seeds the generator; state gets expanded from 'seed' via splitmix64
+    void Seed(uint64_t seed) {
+        for (uint8_t i = 0; i < SDL_arraysize(s); ++i) {
+            uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            s[i] = (uint32_t)((z ^ (z >> 31)) >> 32);
+        }
+    }
+    
+    // Next -- gets the next 32 random bits
+    uint32_t Next() {
+        const uint32_t result = Rotl(s[1] * 5, 7) * 9;
+        const uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = Rotl(s[3], 11);
+        return result;
+    }
+    
+    static uint32_t Rotl(uint32_t x, int k) {
+        return (x << k) | (x >> (32 - k));
+    }
+};
+
+// MathRandRangeF -- get random float in inclusive-range; granularity limited to 24 bits
+float MathRandRangeF(Rand * rand, float a, float b)
 {
     float max = SDL_max(a, b);
     float min = SDL_min(a, b);
-    return min + ((((float)rand()) / ((float)RAND_MAX)) * (max - min));
+    return min + ((((float)(rand->Next() >> 8)) / 16777215.f) * (max - min));
+}
+
+// MathRandRangeI -- get random int in inclusive-range; granularity limited to 24 bits
+int MathRandRangeI(Rand * rand, int a, int b)
+{
+#if PHYSICS_FIXED_POINT
+    const int max = SDL_max(a, b);
+    const int min = SDL_min(a, b);
+    return min + (int)((((int64_t)(rand->Next() >> 8) * (max - min)) + 8388607) / 16777215);
+#else
+    return MathRound(MathRandRangeF(rand, a, b));
+#endif
+}
+
+// MathRandRangeR -- get random physics number in inclusive-range; granularity limited to 24 bits
+Real MathRandRangeR(Rand * rand, Real a, Real b)
+{
+#if PHYSICS_FIXED_POINT
+    const Real max = SDL_max(a, b);
+    const Real min = SDL_min(a, b);
+    return min + Fixed::FromRaw(((int64_t)(rand->Next() >> 8) * (max - min).raw) / 16777215);
+#else
+    return MathRandRangeF(rand, a, b);
+#endif
+}
+
+// MathCountTrailingZeros -- number of 0 bits below the lowest 1 bit; 'x' must be non-zero
+int MathCountTrailingZeros(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    while ( ! (x & 1)) {
+        x >>= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// MathCountLeadingZeros -- number of 0 bits above the highest 1 bit; 'x' must be non-zero
+int MathCountLeadingZeros(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    while ( ! (x & 0x8000000000000000ull)) {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+// MathCountOnes -- number of 1 bits
+int MathCountOnes(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    int n = 0;
+    for ( ; x; x &= x - 1) {
+        ++n;
+    }
+    return n;
+#endif
 }
 
-// MathRandRangeF -- get random int in inclusive-range; granularity limited to RAND_MAX
-int MathRandRangeI(int a, int b)
+// MathSweepCircleRect -- finds when a circle, of radius 'r', centered at (x, y),
+//   and moving by (dx, dy), first touches a rect.  Returns SDL_TRUE, along with
+//   the fraction of the move (0 to 1) that gets made before touching, if it
+//   does.  Circles that start out touching the rect are not considered to hit it.
+SDL_bool MathSweepCircleRect(Real x, Real y, Real dx, Real dy, Real r,
+                             Real left, Real top, Real right, Real bottom,
+                             Real * outT)
 {
-    return MathRound(MathRandRangeF(a, b));
+    // Find when the circle's center enters the rect, grown by 'r' on each
+    // side, one axis at a time
+    Real tEnter = 0.f;
+    Real tExit = 1.f;
+    const Real p[2] = {x, y};
+    const Real d[2] = {dx, dy};
+    const Real lo[2] = {left - r, top - r};
+    const Real hi[2] = {right + r, bottom + r};
+    for (uint8_t axis = 0; axis < 2; ++axis) {
+        if (d[axis] == Real(0.f)) {
+            if (p[axis] < lo[axis] || p[axis] > hi[axis]) {
+                return SDL_FALSE;
+            }
+        } else {
+            Real t0 = (lo[axis] - p[axis]) / d[axis];
+            Real t1 = (hi[axis] - p[axis]) / d[axis];
+            if (t0 > t1) {
+                const Real swap = t0;
+                t0 = t1;
+                t1 = swap;
+            }
+            tEnter = SDL_max(tEnter, t0);
+            tExit = SDL_min(tExit, t1);
+            if (tEnter > tExit) {
+                return SDL_FALSE;
+            }
+        }
+    }
+    
+    // The grown rect's corners are square, whereas the circle's path around the
+    // real rect's corners is round.  If the center enters (or starts in) a
+    // corner, check against a circle around that corner, instead.
+    // (The quadratic is divided through by 'a' first, which keeps its terms in
+    // range for fixed-point numbers.)
+    const Real hx = x + (dx * tEnter);
+    const Real hy = y + (dy * tEnter);
+    if ((hx < left || hx > right) && (hy < top || hy > bottom)) {
+        const Real mx = x - ((hx < left) ? left : right);
+        const Real my = y - ((hy < top) ? top : bottom);
+        const Real a = (dx * dx) + (dy * dy);
+        const Real b = ((mx * dx) + (my * dy)) / a;
+        const Real c = ((mx * mx) + (my * my) - (r * r)) / a;
+        const Real discriminant = (b * b) - c;
+        if (c <= Real(0.f) || b >= Real(0.f) || discriminant < Real(0.f)) {
+            return SDL_FALSE;
+        }
+        tEnter = -b - RealSqrt(discriminant);
+        if (tEnter > Real(1.f)) {
+            return SDL_FALSE;
+        }
+    } else if (tEnter <= Real(0.f)) {
+        return SDL_FALSE;
+    }
+    
+    *outT = tEnter;
+    return SDL_TRUE;
 }
 
 // RectSet -- sets the contents of an SDL_Rect
@@ -214,6 +503,49 @@ void RectSet(SDL_Rect * r, int x, int y, int w, int h)
 }
 
 
+//   
+//    #####   #          #                  
+//      #        ## #         # ##    ####  
+//      #     #  # # #   #    ##  #  #   #  
+//      #     #  # # #   #    #   #   ####  
+//      #     #  #   #   #    #   #      #  
+//                                    ###   
+#pragma mark - Timing
+static uint16_t TicksPerSecond = 100;               // game-ticks per second; set once, at startup, before any match starts (via '--tick-rate N')
+static const uint16_t TicksPerSecondMin = 10;
+static const uint16_t TicksPerSecondMax = 1000;
+
+// TimingPerTick -- converts a per-second rate (a velocity, say) into a per-game-tick one
+Real TimingPerTick(float perSecond)
+{
+    return Real(perSecond) / Real((float)TicksPerSecond);
+}
+
+// TimingPerTickPerTick -- converts a per-second-per-second rate (an
+//   acceleration) into a per-game-tick-per-game-tick one
+Real TimingPerTickPerTick(float perSecondPerSecond)
+{
+#if PHYSICS_FIXED_POINT
+    return TimingPerTick(perSecondPerSecond) / Real((int)TicksPerSecond);     // (TicksPerSecond squared might not fit)
+#else
+    return perSecondPerSecond / (float)((uint32_t)TicksPerSecond * TicksPerSecond);
+#endif
+}
+
+// TimingSecondsToTicks -- converts a duration into a number of game-ticks; never less than 1
+int TimingSecondsToTicks(float seconds)
+{
+#if PHYSICS_FIXED_POINT
+    // In integer math, via whole milliseconds, as Real(seconds) * TicksPerSecond
+    // might not fit in a Fixed
+    const int64_t milliseconds = (((int64_t)Real(seconds).raw * 1000) + 0x8000) >> 16;
+    return (int)SDL_max(1, ((milliseconds * TicksPerSecond) + 500) / 1000);
+#else
+    return SDL_max(1, MathRound(seconds * (float)TicksPerSecond));
+#endif
+}
+
+
 //   
 //    #####                 #    
 //      #     ###   #  #   ####  
@@ -349,6 +681,71 @@ SDL_bool FontPreloadAll()
     return SDL_TRUE;
 }
 
+// TextBlendRow -- blends one row of a glyph into 'dst': 'count' pixels, in the
+//   game's RGBA8888 layout (see ImageRMask, etc.), each towards 'color' (in
+//   that same layout) by its coverage in 'alphas'.  Per channel, that's
+//   ((255 - alpha) * dst + alpha * color) >> 8, as TextDrawChar() blends
+//   other layouts; dst's alpha channel is left as-is.
+static_assert(ImageRMask == 0x000000ff && ImageGMask == 0x0000ff00 && ImageBMask == 0x00ff0000 && ImageAMask == 0xff000000,
+              "TextBlendRow() needs RGBA8888 pixels, in byte order");
+#if __SSE2__
+static const char * TextBlendKernelName = "SSE2";
+#elif __ARM_NEON && TEXT_BLEND_NEON
+static const char * TextBlendKernelName = "NEON";
+#else
+static const char * TextBlendKernelName = "scalar";
+#endif
+static uint8_t TextBlendUseKernel = 1;     // 0 to blend via the surface's format masks, even for RGBA8888 (for '--bench-text')
+static void TextBlendRow(uint32_t * dst, const uint8_t * alphas, uint32_t color, uint16_t count)
+{
+    uint16_t i = 0;
+#if __SSE2__
+    // 4 pixels at a time, as 2 halves of 8 16-bit channels each
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi16(255);
+    const __m128i color16 = _mm_unpacklo_epi8(_mm_set1_epi32((int)color), zero);
+    const __m128i alphaMask = _mm_set1_epi32((int)ImageAMask);
+    for (; (i + 4) <= count; i += 4) {
+        const __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        uint32_t coverage;
+        SDL_memcpy(&coverage, alphas + i, sizeof(coverage));
+        __m128i a = _mm_cvtsi32_si128((int)coverage);
+        a = _mm_unpacklo_epi8(a, a);
+        a = _mm_unpacklo_epi16(a, a);       // each pixel's coverage, in each of its channels
+        const __m128i aLo = _mm_unpacklo_epi8(a, zero);
+        const __m128i aHi = _mm_unpackhi_epi8(a, zero);
+        const __m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(max, aLo)),
+                                                        _mm_mullo_epi16(color16, aLo)), 8);
+        const __m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(max, aHi)),
+                                                        _mm_mullo_epi16(color16, aHi)), 8);
+        const __m128i blended = _mm_packus_epi16(lo, hi);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_andnot_si128(alphaMask, blended), _mm_and_si128(alphaMask, d)));
+    }
+#elif __ARM_NEON && TEXT_BLEND_NEON
+    // 8 pixels at a time, split into one vector per channel
+    const uint8x8_t colorR = vdup_n_u8((uint8_t)(color & 0xff));
+    const uint8x8_t colorG = vdup_n_u8((uint8_t)((color >> 8) & 0xff));
+    const uint8x8_t colorB = vdup_n_u8((uint8_t)((color >> 16) & 0xff));
+    for (; (i + 8) <= count; i += 8) {
+        uint8x8x4_t d = vld4_u8((const uint8_t *)(dst + i));
+        const uint8x8_t a = vld1_u8(alphas + i);
+        const uint8x8_t inverse = vmvn_u8(a);      // 255 - a
+        d.val[0] = vshrn_n_u16(vmlal_u8(vmull_u8(d.val[0], inverse), colorR, a), 8);
+        d.val[1] = vshrn_n_u16(vmlal_u8(vmull_u8(d.val[1], inverse), colorG, a), 8);
+        d.val[2] = vshrn_n_u16(vmlal_u8(vmull_u8(d.val[2], inverse), colorB, a), 8);
+        vst4_u8((uint8_t *)(dst + i), d);
+    }
+#endif
+    for (; i < count; ++i) {
+        const uint32_t a = alphas[i];
+        const uint32_t d = dst[i];
+        const uint32_t dr = (((255 - a) * (d & 0xff)) + (a * (color & 0xff))) >> 8;
+        const uint32_t dg = (((255 - a) * ((d >> 8) & 0xff)) + (a * ((color >> 8) & 0xff))) >> 8;
+        const uint32_t db = (((255 - a) * ((d >> 16) & 0xff)) + (a * ((color >> 16) & 0xff))) >> 8;
+        dst[i] = (d & ImageAMask) | dr | (dg << 8) | (db << 16);
+    }
+}
+
 // TextDrawChar-- renders a single character onto the global 'Screen'
 void TextDrawChar(FontID fontID, uint8_t r, uint8_t g, uint8_t b, int16_t * scrx, int16_t * scry, unsigned char ch)
 {
@@ -358,6 +755,20 @@ void TextDrawChar(FontID fontID, uint8_t r, uint8_t g, uint8_t b, int16_t * scrx
         return;
     }
     FontChar * baked = &Fonts[fontID].baked.chars[ch - FontFirstChar];
+    const SDL_PixelFormat * format = Screen->format;
+    if (TextBlendUseKernel && format->BytesPerPixel == 4 &&
+        format->Rmask == ImageRMask && format->Gmask == ImageGMask && format->Bmask == ImageBMask && format->Amask == ImageAMask)
+    {
+        const uint32_t color = SDL_MapRGBA(format, r, g, b, 0);
+        const int16_t dx = *scrx + MathRound(baked->xoff);
+        for (uint16_t iy = 0; iy < baked->h; ++iy) {
+            const int16_t dy = *scry + Fonts[fontID].baked.ascent + baked->yoff + iy;
+            uint32_t * row = (uint32_t *)((uint8_t *)Screen->pixels + (dy * Screen->pitch));
+            TextBlendRow(row + dx, &Fonts[fontID].baked.bitmap[baked->x + ((baked->y + iy) * FontBitmapWidth)], color, baked->w);
+        }
+        *scrx += baked->xadvance;
+        return;
+    }
     for (uint16_t iy = 0; iy < baked->h; ++iy) {
         for (uint16_t ix = 0; ix < baked->w; ++ix) {
             int16_t sx = baked->x + ix;
@@ -365,7 +776,8 @@ void TextDrawChar(FontID fontID, uint8_t r, uint8_t g, uint8_t b, int16_t * scrx
             int16_t dx = *scrx + MathRound(baked->xoff) + ix;
             int16_t dy = *scry + Fonts[fontID].baked.ascent + baked->yoff + iy;
             
-            uint32_t dp = ((uint32_t *)Screen->pixels)[dx + (dy * Screen->w)];
+            uint32_t * row = (uint32_t *)((uint8_t *)Screen->pixels + (dy * Screen->pitch));
+            uint32_t dp = row[dx];
             uint8_t dr = (dp & Screen->format->Rmask) >> Screen->format->Rshift;
             uint8_t dg = (dp & Screen->format->Gmask) >> Screen->format->Gshift;
             uint8_t db = (dp & Screen->format->Bmask) >> Screen->format->Bshift;
@@ -385,7 +797,7 @@ void TextDrawChar(FontID fontID, uint8_t r, uint8_t g, uint8_t b, int16_t * scrx
                 (db << Screen->format->Bshift) |
                 (da << Screen->format->Ashift);
             
-            ((uint32_t *)Screen->pixels)[dx + (dy * ScreenWidth)] = dp;
+            row[dx] = dp;
         }
     }
     *scrx += baked->xadvance;
@@ -411,6 +823,135 @@ void TextDraw(FontID fontID, uint8_t r, uint8_t g, uint8_t b, int16_t x, int16_t
     va_end(ap);
 }
 
+// TextCache -- recently drawn strings, pre-rendered over a solid background
+//   color, so that drawing one again (over that same color) is a plain copy,
+//   rather than a blend of each of its glyphs' pixels.  When full, the least
+//   recently drawn string gets replaced.
+static const uint8_t TextCacheSize = 16;
+static const uint8_t TextCacheMaxLength = 63;   // longer strings don't get cached
+struct TextCacheEntry {
+    SDL_Surface * image;        // the string, as drawn; NULL if the entry is unused
+    FontID fontID;
+    uint32_t color;             // text color, as 0xRRGGBB
+    uint32_t background;        // background color, as 0xRRGGBB
+    char text[TextCacheMaxLength + 1];
+    int16_t offsetX;            // from the string's drawing position, to the image's top-left
+    int16_t offsetY;
+    uint32_t lastUsed;          // TextCacheClock, as of the string's last draw
+};
+static TextCacheEntry TextCache[TextCacheSize];
+static uint32_t TextCacheClock = 0;
+
+// TextCacheRender -- draws a string into a cache entry's image, exactly as
+//   TextDraw() would over the background color
+static SDL_bool TextCacheRender(TextCacheEntry * entry)
+{
+    // Find the box that the string's glyphs cover, relative to its drawing position
+    const Font * font = &Fonts[entry->fontID];
+    int16_t minX = INT16_MAX, minY = INT16_MAX, maxX = INT16_MIN, maxY = INT16_MIN;
+    int16_t curx = 0;
+    for (const char * c = entry->text; *c != '\0'; ++c) {
+        const unsigned char ch = (unsigned char) *c;
+        if (ch < FontFirstChar || ch >= (FontFirstChar + FontCharCount)) {
+            continue;
+        }
+        const FontChar * baked = &font->baked.chars[ch - FontFirstChar];
+        if (baked->w > 0 && baked->h > 0) {
+            const int16_t x = curx + MathRound(baked->xoff);
+            const int16_t y = font->baked.ascent + baked->yoff;
+            minX = SDL_min(minX, x);
+            minY = SDL_min(minY, y);
+            maxX = SDL_max(maxX, (int16_t)(x + baked->w));
+            maxY = SDL_max(maxY, (int16_t)(y + baked->h));
+        }
+        curx += baked->xadvance;
+    }
+    if (minX >= maxX) {
+        return SDL_FALSE;       // nothing to draw
+    }
+    
+    entry->image = SDL_CreateRGBSurface(0, maxX - minX, maxY - minY, 32, ImageRMask, ImageGMask, ImageBMask, ImageAMask);
+    if ( ! entry->image) {
+        SDL_Log("%s, SDL_CreateRGBSurface failed: %s", __FUNCTION__, SDL_GetError());
+        return SDL_FALSE;
+    }
+    SDL_SetSurfaceBlendMode(entry->image, SDL_BLENDMODE_NONE);
+    SDL_FillRect(entry->image, NULL, SDL_MapRGB(entry->image->format,
+                                                (entry->background >> 16) & 0xff, (entry->background >> 8) & 0xff, entry->background & 0xff));
+    entry->offsetX = minX;
+    entry->offsetY = minY;
+    
+    // Glyphs get drawn onto the global 'Screen', so point it at the image, for now
+    SDL_Surface * screen = Screen;
+    Screen = entry->image;
+    curx = -minX;
+    int16_t cury = -minY;
+    for (const char * c = entry->text; *c != '\0'; ++c) {
+        TextDrawChar(entry->fontID, (entry->color >> 16) & 0xff, (entry->color >> 8) & 0xff, entry->color & 0xff, &curx, &cury, *c);
+    }
+    Screen = screen;
+    return SDL_TRUE;
+}
+
+// TextDrawCached -- renders a string of characters onto the global 'Screen',
+//   where it's known to be over a solid background color (bgr, bgg, bgb),
+//   using TextCache
+void TextDrawCached(FontID fontID, uint8_t r, uint8_t g, uint8_t b, uint8_t bgr, uint8_t bgg, uint8_t bgb, int16_t x, int16_t y, const char * textFormat, ...)
+{
+    if (fontID < 0 || fontID >= SDL_arraysize(Fonts)) {
+        return;
+    }
+    va_list ap;
+    va_start(ap, textFormat);
+    char formatted[TextCacheMaxLength + 2];
+    const int length = SDL_vsnprintf(formatted, SDL_arraysize(formatted), textFormat, ap);
+    va_end(ap);
+    if (length < 0 || length > TextCacheMaxLength) {
+        va_start(ap, textFormat);
+        char uncached[1024];
+        SDL_vsnprintf(uncached, SDL_arraysize(uncached), textFormat, ap);
+        va_end(ap);
+        TextDraw(fontID, r, g, b, x, y, "%s", uncached);
+        return;
+    }
+    
+    // Find the string, or else the entry to replace with it
+    const uint32_t color = (r << 16) | (g << 8) | b;
+    const uint32_t background = (bgr << 16) | (bgg << 8) | bgb;
+    TextCacheEntry * entry = NULL;
+    TextCacheEntry * oldest = &TextCache[0];
+    for (uint8_t i = 0; i < TextCacheSize; ++i) {
+        TextCacheEntry * candidate = &TextCache[i];
+        if (candidate->image && candidate->fontID == fontID && candidate->color == color &&
+            candidate->background == background && SDL_strcmp(candidate->text, formatted) == 0)
+        {
+            entry = candidate;
+            break;
+        }
+        if ( ! candidate->image || (oldest->image && candidate->lastUsed < oldest->lastUsed)) {
+            oldest = candidate;
+        }
+    }
+    if ( ! entry) {
+        entry = oldest;
+        if (entry->image) {
+            SDL_FreeSurface(entry->image);
+            entry->image = NULL;
+        }
+        entry->fontID = fontID;
+        entry->color = color;
+        entry->background = background;
+        SDL_strlcpy(entry->text, formatted, sizeof(entry->text));
+        if ( ! TextCacheRender(entry)) {
+            return;
+        }
+    }
+    entry->lastUsed = ++TextCacheClock;
+    
+    SDL_Rect dst = { x + entry->offsetX, y + entry->offsetY, entry->image->w, entry->image->h };
+    SDL_BlitSurface(entry->image, NULL, Screen, &dst);
+}
+
 
 //   
 //    #   #  #   #  ####  
@@ -439,34 +980,41 @@ static const int16_t HUDScoresYOffset = 8;
 //    ####    ## #   ###    ###   ####  
 //                                      
 #pragma mark - Balls
-static const float BallRadius = 10.f;
-static const float BallChopVelocityY = 2.0f;    // 'chop' ball's Y-velocity to this, on particular collisions
+static const uint16_t BallDefaultCapacity = 8;  // max number of balls, per match, unless otherwise specified (via GameStateCreate())
+static const Real BallRadius = 10.f;
+static const float BallChopVelocityY = 200.f;   // 'chop' ball's Y-velocity to this (in pixels per second), on particular collisions
+static const float BallSpawnSpeedX[] = {50.f, 300.f};   // range of a new ball's X-speed, in pixels per second
+static const float BallSpawnSpeedY[] = {50.f, 200.f};   // range of a new ball's Y-speed, in pixels per second
+static const uint8_t BallSize = 20;             // width + height of ball images
+static const Real BallSweepPenetration = 2.f;  // fast balls get stopped this far (along their path) into whatever they hit, so that overlap tests see the hit
 enum BallType : uint8_t {
     BallTypeInactive = 0,
     BallTypeNoPlayer,
     BallTypeBlue,
-    BallTypeRed
+    BallTypeRed,
+    BallTypeCount
 };
+static uint32_t BallMasks[BallTypeCount][BallSize];     // per-row masks of non-transparent pixels, in each BallType's image
 struct Ball {
-    float cx;       // Center X
-    float cy;       // Center Y
-    float vx;       // Velocity, X
-    float vy;       // Velocity, Y
+    Real cx;        // Center X
+    Real cy;        // Center Y
+    Real vx;        // Velocity, X
+    Real vy;        // Velocity, Y
     BallType type;  // Blue?  Red?  Other?
     
-    float Left() const {
+    Real Left() const {
         return cx - BallRadius;
     }
     
-    float Right() const {
+    Real Right() const {
         return cx + BallRadius;
     }
     
-    float Top() const {
+    Real Top() const {
         return cy - BallRadius;
     }
     
-    float Bottom() const {
+    Real Bottom() const {
         return cy + BallRadius;
     }
     
@@ -477,20 +1025,60 @@ struct Ball {
     // Limits y-velocity to a global threshold.  This prevents the ball from
     // bouncing up and down too fast.
     void ChopVY() {
-        if (vy > BallChopVelocityY) {
-            vy = BallChopVelocityY;
+        const Real chop = TimingPerTick(BallChopVelocityY);
+        if (vy > chop) {
+            vy = chop;
 //            SDL_Log("vy, fix: %f", vy);
-        } else if (vy < -BallChopVelocityY) {
-            vy = -BallChopVelocityY;
+        } else if (vy < -chop) {
+            vy = -chop;
 //            SDL_Log("vy, fix: %f", vy);
         }
     }
     
+    // IsFast -- is the ball moving more than its radius per game-tick?  Such
+    //   balls could skip over things, and need to be moved with a sweep.
+    bool IsFast() const {
+        return (vx > BallRadius) || (vx < -BallRadius) || (vy > BallRadius) || (vy < -BallRadius);
+    }
+    
+    // Move -- moves the ball by its velocity, bouncing it off of any walls
+    void Move() {
+        MovePart(1.f);
+    }
+    
+    // MovePart -- moves the ball by a fraction (0 to 1) of its velocity,
+    //   bouncing it off of any walls
+    void MovePart(Real t) {
+        cx += vx * t;
+        cy += vy * t;
+        
+        // Ball/wall collisions
+        if ((Bottom()) > Real(ScreenHeight - HUDHeight)) {
+            // Collision, bottom-wall
+            cy = Real(ScreenHeight - HUDHeight) - BallRadius;
+            vy *= -1.f;
+            ChopVY();
+        } else if ((Top()) < Real(0.f)) {
+            // Collision, top-wall
+            cy = BallRadius;
+            vy *= -1.f;
+            ChopVY();
+        } else if ((Right()) > Real(ScreenWidth)) {
+            // Collision, right-wall
+            cx = Real(ScreenWidth) - BallRadius;
+            vx *= -1.f;
+        } else if ((Left()) < Real(0.f)) {
+            // Collision, left-wall
+            cx = BallRadius;
+            vx *= -1.f;
+        }
+    }
+    
     void GetRect(SDL_Rect * r) const {
         r->x = MathRound(Left());
         r->y = MathRound(Top());
-        r->w = MathRound(BallRadius * 2.f);
-        r->h = MathRound(BallRadius * 2.f);
+        r->w = MathRound(BallRadius * Real(2.f));
+        r->h = MathRound(BallRadius * Real(2.f));
     }
     
     SDL_Surface * GetImage() const {
@@ -501,22 +1089,30 @@ struct Ball {
             default:                return NULL;
         }
     }
-} Balls[8];
+    
+    // GetMask -- gets per-row masks of the ball's non-transparent pixels; NULL if inactive
+    const uint32_t * GetMask() const {
+        switch (type) {
+            case BallTypeBlue:
+            case BallTypeNoPlayer:
+            case BallTypeRed:       return BallMasks[type];
+            default:                return NULL;
+        }
+    }
+};
 
-// BallRespawn -- [re]spawns an existing ball
-void BallRespawn(uint8_t ballIndex)
+// BallRespawn -- [re]spawns an existing ball, using the match's random number generator
+void BallRespawn(Ball * ball, Rand * rand)
 {
-//    SDL_Log("BallRespawn(%u)", ballIndex);
-    SDL_assert_paranoid(ballIndex < SDL_arraysize(Balls));
-    Balls[ballIndex].cx = ScreenWidth / 2.f;
-    Balls[ballIndex].cy = (ScreenHeight - HUDHeight) / 2.f;
-    Balls[ballIndex].vx = MathRandRangeF(0.5f, 3.0f) * (MathRandRangeI(0,1) ? 1.f : -1.f);
-    Balls[ballIndex].vy = MathRandRangeF(0.5f, 2.0f) * (MathRandRangeI(0,1) ? 1.f : -1.f);
-//    Balls[ballIndex].vx = 1.6f;       // Ball/Powerup collision testing, Y-axis
-//    Balls[ballIndex].vy = 0.32f;
-//    Balls[ballIndex].vx = 0.32f;        // Ball/Powerup collision testing, X-axis
-//    Balls[ballIndex].vy = 1.6f;
-    Balls[ballIndex].type = BallTypeNoPlayer;
+    ball->cx = ScreenWidth / 2.f;
+    ball->cy = (ScreenHeight - HUDHeight) / 2.f;
+    ball->vx = MathRandRangeR(rand, TimingPerTick(BallSpawnSpeedX[0]), TimingPerTick(BallSpawnSpeedX[1])) * Real(MathRandRangeI(rand, 0,1) ? 1.f : -1.f);
+    ball->vy = MathRandRangeR(rand, TimingPerTick(BallSpawnSpeedY[0]), TimingPerTick(BallSpawnSpeedY[1])) * Real(MathRandRangeI(rand, 0,1) ? 1.f : -1.f);
+//    ball->vx = 1.6f;       // Ball/Powerup collision testing, Y-axis
+//    ball->vy = 0.32f;
+//    ball->vx = 0.32f;        // Ball/Powerup collision testing, X-axis
+//    ball->vy = 1.6f;
+    ball->type = BallTypeNoPlayer;
 }
 
 
@@ -528,16 +1124,62 @@ void BallRespawn(uint8_t ballIndex)
 //    #       ## #   ####   ####   ###    ###   ####  
 //                                                    
 #pragma mark - Paddles
-static const float PaddleVStep = 0.1f;          // adjust moving paddle(s) Y-velocity by this much, per game-tick
+static const uint8_t PaddleCount = 2;
+static const float PaddleVStep = 1000.f;        // adjust moving paddle(s) Y-velocity by this much, in pixels per second, per second
 static const int16_t PaddleMaxH = 150;
 static const int8_t PaddleMargin = 16;          // diff from screen edge, to paddle edge
 static const uint16_t PaddleWidth = 16;
 static const int16_t PaddleXs[] = { PaddleMargin, ScreenWidth - PaddleMargin - PaddleWidth };
-static const float PaddleToBallFriction = 1.f;  // how much should a paddle's Y-velocity be applied to colliding ball(s)?
-static const uint16_t PaddleDefaultLaserRechargeTicks = 450;    // default number of game-ticks (10 ms per tick) to wait for laser rechaarge
+static const Real PaddleToBallFriction = 1.f;  // how much should a paddle's Y-velocity be applied to colliding ball(s)?
+static const float PaddleDefaultLaserRechargeTime = 4.5f;      // default number of seconds to wait for laser recharge
+static const uint8_t PaddleRowWords = (PaddleMaxH + 63) / 64;
+static uint16_t PaddleTemplateMasks[PaddleCount][PaddleMaxH];   // per-row masks of fully-opaque pixels, in each restored paddle's image
+static uint64_t PaddleTemplateRows[PaddleCount][PaddleRowWords];    // 1 bit per non-empty row, in PaddleTemplateMasks
+static const uint8_t PaddleMaxCuts = (PaddleMaxH + 1) / 2;      // most separate cuts a paddle can have (each needs an uncut row between it and the next)
+
+// PaddleCutRows -- a run of rows, [top, bottom), cut out of a paddle by lasers.
+//   Lasers cross the whole of a paddle, so cuts always take out whole rows.
+struct PaddleCutRows {
+    uint8_t top;
+    uint8_t bottom;
+};
+
+// PaddleTemplateFirstRow -- finds the first non-empty row, in [from, to), of
+//   a restored paddle's image; or 'to' if there are none
+static int16_t PaddleTemplateFirstRow(uint8_t paddleIndex, int16_t from, int16_t to) {
+    for (int16_t w = from / 64; w < PaddleRowWords && (w * 64) < to; ++w) {
+        uint64_t bits = PaddleTemplateRows[paddleIndex][w];
+        if (w == (from / 64)) {
+            bits &= ~0ull << (from % 64);
+        }
+        if (bits) {
+            return SDL_min((w * 64) + MathCountTrailingZeros(bits), to);
+        }
+    }
+    return to;
+}
+
+// PaddleTemplateLastRow -- finds the last non-empty row, in [from, to), of a
+//   restored paddle's image; or 'from - 1' if there are none
+static int16_t PaddleTemplateLastRow(uint8_t paddleIndex, int16_t from, int16_t to) {
+    if (to <= from) {
+        return from - 1;
+    }
+    for (int16_t w = (to - 1) / 64; w >= 0 && ((w + 1) * 64) > from; --w) {
+        uint64_t bits = PaddleTemplateRows[paddleIndex][w];
+        if (w == ((to - 1) / 64)) {
+            bits &= ~0ull >> (63 - ((to - 1) % 64));
+        }
+        if (bits) {
+            return SDL_max((w * 64) + 63 - MathCountLeadingZeros(bits), from - 1);
+        }
+    }
+    return from - 1;
+}
+
 struct Paddle {
-    float y;            // Y (paddle-top)
-    float vy;           // Velocity, Y
+    Real y;             // Y (paddle-top)
+    Real vy;            // Velocity, Y
     uint16_t x : 14;    // X (paddle-left)
     signed ballBounceDirection : 2;     // Which direction should colliding ball(s) be sent in (along the X axis)
     BallType ballType;  // Convert colliding ball(s) to this BallType
@@ -549,6 +1191,9 @@ struct Paddle {
     SDL_Scancode keyDown;   // press this to move down
     SDL_Scancode keyLaser;  // press this to fire laser
     
+    uint8_t numCuts;
+    PaddleCutRows cuts[PaddleMaxCuts];  // cut-out rows, sorted, neither overlapping nor touching; unused ones are zeroed
+    
     uint16_t Left() const {
         return x;
     }
@@ -557,11 +1202,11 @@ struct Paddle {
         return x + PaddleWidth;
     }
     
-    float Top() const {
+    Real Top() const {
         return y;
     }
     
-    float Bottom() const {
+    Real Bottom() const {
         return y + PaddleMaxH;
     }
     
@@ -572,15 +1217,6 @@ struct Paddle {
         r->h = PaddleMaxH;
     }
     
-    // GetImage -- convert paddleIndex (0 or 1) to appropriate SDL_Surface
-    static SDL_Surface * GetImage(uint8_t paddleIndex) {
-        switch (paddleIndex) {
-            case 0:  return Images[ImageIDPaddleBlue];
-            case 1:  return Images[ImageIDPaddleRed];
-            default: return NULL;
-        }
-    }
-    
     // GetImageTemplate -- convert paddleIndex to an appropriate SDL_Surface, for a restored paddle
     static SDL_Surface * GetImageTemplate(uint8_t paddleIndex) {
         switch (paddleIndex) {
@@ -590,33 +1226,147 @@ struct Paddle {
         }
     }
     
-    // CalcEdge -- computes a new top, or bottom, for paddle; called as part of paddle-cutting algorithm
-    static int16_t CalcEdge(SDL_Surface * paddleImage, int16_t ystart, int16_t yend, int16_t ystep) {
-        int16_t y;
-        for (y = ystart; y != (yend + ystep); y += ystep) {
-            for (int16_t x = 0; x < PaddleWidth; ++x) {
-                uint32_t a = ImageGetAlphaUnshifted(paddleImage, x, y);
-                if ((a >> paddleImage->format->Ashift) == 0xff) {
-                    return y;
+    // CalcEdgeDown -- finds the first solid row at, or below, ystart; or PaddleMaxH if there are none
+    int16_t CalcEdgeDown(uint8_t paddleIndex, int16_t ystart) const {
+        int16_t y = ystart;
+        for (uint8_t i = 0; i <= numCuts && y < PaddleMaxH; ++i) {
+            const int16_t uncutEnd = (i < numCuts) ? cuts[i].top : PaddleMaxH;
+            if (y < uncutEnd) {
+                const int16_t row = PaddleTemplateFirstRow(paddleIndex, y, uncutEnd);
+                if (row < uncutEnd) {
+                    return row;
                 }
             }
+            if (i < numCuts) {
+                y = SDL_max(y, (int16_t)cuts[i].bottom);
+            }
         }
-        return y;
+        return PaddleMaxH;
     }
-} Paddles[2];
+    
+    // CalcEdgeUp -- finds the last solid row at, or above, ystart; or -1 if there are none
+    int16_t CalcEdgeUp(uint8_t paddleIndex, int16_t ystart) const {
+        int16_t y = ystart + 1;
+        for (int16_t i = numCuts; i >= 0 && y > 0; --i) {
+            const int16_t uncutStart = (i > 0) ? cuts[i - 1].bottom : 0;
+            if (uncutStart < y) {
+                const int16_t row = PaddleTemplateLastRow(paddleIndex, uncutStart, y);
+                if (row >= uncutStart) {
+                    return row;
+                }
+            }
+            if (i > 0) {
+                y = SDL_min(y, (int16_t)cuts[i - 1].top);
+            }
+        }
+        return -1;
+    }
+    
+    // FindUncutRows -- finds the first run of uncut rows, at or below ystart,
+    //   returning its first row (or PaddleMaxH if there are none), and setting
+    //   '*end' to one past its last row
+    int16_t FindUncutRows(int16_t ystart, int16_t * end) const {
+        int16_t y = ystart;
+        for (uint8_t i = 0; i < numCuts; ++i) {
+            if (y < cuts[i].top) {
+                *end = cuts[i].top;
+                return y;
+            }
+            y = SDL_max(y, (int16_t)cuts[i].bottom);
+        }
+        *end = PaddleMaxH;
+        return SDL_min(y, PaddleMaxH);
+    }
+};
+
+static void PaddleHeal(Paddle * paddle, uint8_t paddleIndex) {
+    if (paddleIndex >= PaddleCount) {
+        return;
+    }
+    paddle->cutTop = 0;
+    paddle->cutBottom = PaddleMaxH;
+    paddle->numCuts = 0;
+    SDL_memset(paddle->cuts, 0, sizeof(paddle->cuts));
+}
 
-static void PaddleHeal(uint8_t paddleIndex) {
-    if (paddleIndex >= SDL_arraysize(Paddles)) {
+// PaddleCut -- cuts rows [top, bottom), in paddle-local coordinates, out of a
+//   paddle, merging them with any cuts that they overlap or touch
+static void PaddleCut(Paddle * paddle, uint8_t paddleIndex, int16_t top, int16_t bottom) {
+    const int16_t cutY = top;
+    const int16_t cutEnd = bottom;
+    top = SDL_max(top, 0);
+    bottom = SDL_min(bottom, PaddleMaxH);
+    if (top >= bottom) {
         return;
     }
-    Paddles[paddleIndex].cutTop = 0;
-    Paddles[paddleIndex].cutBottom = PaddleMaxH;
-    SDL_BlitSurface(Paddle::GetImageTemplate(paddleIndex), NULL, Paddle::GetImage(paddleIndex), NULL);
+    uint8_t first = 0;
+    while (first < paddle->numCuts && paddle->cuts[first].bottom < top) {
+        ++first;
+    }
+    uint8_t last = first;
+    while (last < paddle->numCuts && paddle->cuts[last].top <= bottom) {
+        ++last;
+    }
+    if (first < last) {
+        top = SDL_min(top, (int16_t)paddle->cuts[first].top);
+        bottom = SDL_max(bottom, (int16_t)paddle->cuts[last - 1].bottom);
+    }
+    // (Cuts that don't touch others leave an uncut row on either side, so
+    // there's always room for one more.)
+    SDL_memmove(&paddle->cuts[first + 1], &paddle->cuts[last], (paddle->numCuts - last) * sizeof(PaddleCutRows));
+    const uint8_t oldNumCuts = paddle->numCuts;
+    paddle->numCuts = (uint8_t)(paddle->numCuts + 1 - (last - first));
+    paddle->cuts[first].top = (uint8_t)top;
+    paddle->cuts[first].bottom = (uint8_t)bottom;
+    if (paddle->numCuts < oldNumCuts) {
+        SDL_memset(&paddle->cuts[paddle->numCuts], 0, (oldNumCuts - paddle->numCuts) * sizeof(PaddleCutRows));
+    }
+    
+    if ((cutY <= paddle->cutTop) && (cutEnd >= paddle->cutTop)) {
+        paddle->cutTop = paddle->CalcEdgeDown(paddleIndex, cutEnd);
+    }
+    if ((cutY <= paddle->cutBottom) && (cutEnd >= paddle->cutBottom)) {
+        // cutBottom is one past the last solid row
+        paddle->cutBottom = 1 + paddle->CalcEdgeUp(paddleIndex, cutY);
+    }
+}
+
+// PaddleRender -- draws a paddle's solid, uncut pixels into a PaddleWidth x
+//   PaddleMaxH surface, in the same format as the paddle's template image
+static void PaddleRender(const Paddle * paddle, uint8_t paddleIndex, SDL_Surface * dst) {
+    SDL_Surface * paddleTemplate = Paddle::GetImageTemplate(paddleIndex);
+    if (SDL_MUSTLOCK(dst)) {
+        SDL_LockSurface(dst);
+    }
+    int16_t uncutEnd;
+    int16_t uncutStart = paddle->FindUncutRows(0, &uncutEnd);
+    for (int16_t y = 0; y < PaddleMaxH; ++y) {
+        if (y >= uncutEnd) {
+            uncutStart = paddle->FindUncutRows(y, &uncutEnd);
+        }
+        const uint16_t rowMask = (y >= uncutStart) ? PaddleTemplateMasks[paddleIndex][y] : 0;
+        const uint32_t * src = (const uint32_t *)((const uint8_t *)paddleTemplate->pixels + (y * paddleTemplate->pitch));
+        uint32_t * row = (uint32_t *)((uint8_t *)dst->pixels + (y * dst->pitch));
+        for (uint16_t x = 0; x < PaddleWidth; ++x) {
+            if (rowMask & (1u << x)) {
+                row[x] = src[x];
+#if DEBUG_PADDLE_DRAWING
+            } else if (PaddleTemplateMasks[paddleIndex][y] & (1u << x)) {
+                row[x] = SDL_MapRGBA(dst->format, 0x00, 0x00, 0x00, 0x34);
+#endif
+            } else {
+                row[x] = 0;
+            }
+        }
+    }
+    if (SDL_MUSTLOCK(dst)) {
+        SDL_UnlockSurface(dst);
+    }
 }
 
-static int8_t PaddleIDForBallType(BallType ballType) {
-    for (int8_t i = 0; i < SDL_arraysize(Paddles); ++i) {
-        if (Paddles[i].ballType == ballType) {
+static int8_t PaddleIDForBallType(const Paddle * paddles, BallType ballType) {
+    for (int8_t i = 0; i < PaddleCount; ++i) {
+        if (paddles[i].ballType == ballType) {
             return i;
         }
     }
@@ -634,13 +1384,14 @@ static int8_t PaddleIDForBallType(BallType ballType) {
 //
 #pragma mark - Powerups
 
-typedef int8_t PowerupID;
+typedef int16_t PowerupID;
+static const uint16_t PowerupDefaultCapacity = 8;   // max number of powerups, per match, unless otherwise specified (via GameStateCreate())
 static const uint8_t PowerupSize = 32;
 static const uint8_t PowerupMargin = 8;     // Prevent other powerups from coming within this many pixels near to it
 static const uint16_t PowerupSpawnRangeX[] = {PaddleMargin + PaddleWidth + 50,  ScreenWidth - PowerupSize - PaddleMargin - PaddleWidth - 50};
 static const uint16_t PowerupSpawnRangeY[] = {50,                               ScreenHeight - HUDHeight - PowerupSize - 50};
-static const uint16_t PowerupMinLifetime = 500;
-static const uint16_t PowerupMaxLifetime = 2000;
+static const float PowerupMinLifetime = 5.f;    // in seconds
+static const float PowerupMaxLifetime = 20.f;   // in seconds
 
 enum : uint8_t {
     PowerupType_Inactive = 0,
@@ -657,6 +1408,10 @@ enum : uint8_t {
     PowerupType_LAST
 };
 static const uint8_t PowerupTypeCount = PowerupType_LAST - 1;
+static const char * const PowerupTypeNames[PowerupType_LAST] = {    // for stats, and such
+    "inactive", "plain", "health", "addBall", "removeBall",
+    "reserved1", "reserved2", "reserved3", "reserved4", "reserved5", "reserved6"
+};
 
 struct Powerup {
     uint16_t x;
@@ -664,84 +1419,208 @@ struct Powerup {
     int16_t gameTicksLeft;
     uint8_t type;
     
-    void GetRect(SDL_Rect * r) {
+    void GetRect(SDL_Rect * r) const {
         r->x = x;
         r->y = y;
         r->w = r->h = PowerupSize;
     }
-} Powerups[8];
+};
 
-static void PowerupRespawn(PowerupID id)
-{
-    if (id < 0 || id >= SDL_arraysize(Powerups)) {
-        return;
+// PowerupSpots -- places that powerups can spawn at, on a lattice over the
+//   spawn range.  Each spot counts the things keeping a powerup from spawning
+//   there: active powerups that it would come within PowerupMargin of, and the
+//   area where balls spawn.  Spots with nothing blocking them are also kept in
+//   a bitmask, so that picking a random one only takes counting bits, however
+//   many powerups there are, and only fails once there's no room left at all.
+//   All of this follows from the powerups' positions, so PowerupSpotsBuild()
+//   can redo it from scratch, as needed (after restoring a snapshot, say).
+static const uint8_t PowerupSpotStep = 8;   // pixels between spots, on both axes
+static const uint16_t PowerupSpotColumns = ((PowerupSpawnRangeX[1] - PowerupSpawnRangeX[0]) / PowerupSpotStep) + 1;
+static const uint16_t PowerupSpotRows = ((PowerupSpawnRangeY[1] - PowerupSpawnRangeY[0]) / PowerupSpotStep) + 1;
+static const uint16_t PowerupSpotCount = PowerupSpotColumns * PowerupSpotRows;
+static const uint16_t PowerupSpotWords = (PowerupSpotCount + 63) / 64;
+static const uint8_t PowerupSpotReach = (PowerupSize + PowerupMargin - 1) / PowerupSpotStep;   // powerups block spots up to this many steps away, on both axes
+struct PowerupSpots {
+    uint8_t blockers[PowerupSpotCount];     // number of things keeping each spot from being used
+    uint64_t freeSpots[PowerupSpotWords];   // 1 bit per spot with no blockers
+    uint16_t freeCount;                     // number of spots with no blockers
+    
+    // Block -- adds (delta = 1) or removes (delta = -1) a powerup at (x, y),
+    //   as a blocker of all spots near it
+    void Block(uint16_t x, uint16_t y, int8_t delta) {
+        const int column = (x - PowerupSpawnRangeX[0]) / PowerupSpotStep;
+        const int row = (y - PowerupSpawnRangeY[0]) / PowerupSpotStep;
+        for (int r = SDL_max(0, row - PowerupSpotReach); r <= SDL_min(PowerupSpotRows - 1, row + PowerupSpotReach); ++r) {
+            for (int c = SDL_max(0, column - PowerupSpotReach); c <= SDL_min(PowerupSpotColumns - 1, column + PowerupSpotReach); ++c) {
+                const uint16_t spot = (r * PowerupSpotColumns) + c;
+                if (delta > 0 && blockers[spot]++ == 0) {
+                    freeSpots[spot / 64] &= ~(1ull << (spot % 64));
+                    --freeCount;
+                } else if (delta < 0 && --blockers[spot] == 0) {
+                    freeSpots[spot / 64] |= (1ull << (spot % 64));
+                    ++freeCount;
+                }
+            }
+        }
     }
     
-    // Try to find an unoccupied spot for the powerup.  If one can't be found
-    // after several tries, give up.
-    SDL_Rect selfRect, otherRect, ballSpawnRect;
-    selfRect.w = selfRect.h = PowerupSize;
-    otherRect.w = otherRect.h = PowerupSize + (PowerupMargin * 2);
+    // PickFree -- gets the index'th spot with no blockers; 'index' must be less than freeCount
+    uint16_t PickFree(uint16_t index) const {
+        for (uint16_t w = 0; ; ++w) {
+            uint64_t bits = freeSpots[w];
+            const int count = MathCountOnes(bits);
+            if (index < count) {
+                for ( ; index > 0; --index) {
+                    bits &= bits - 1;
+                }
+                return (w * 64) + MathCountTrailingZeros(bits);
+            }
+            index -= count;
+        }
+    }
+};
 
-    // Define some space where balls in, without them immediately
-    // colliding with powerups.
-    ballSpawnRect.w = ballSpawnRect.h = ((int)BallRadius) * 8;
+// PowerupSpotsBuild -- works out, from scratch, where powerups can spawn
+static void PowerupSpotsBuild(PowerupSpots * spots, const Powerup * powerups, uint16_t numPowerups)
+{
+    // Keep powerups out of the space where balls spawn, so that new balls
+    // don't immediately collide with them
+    SDL_Rect ballSpawnRect, spotRect;
+    ballSpawnRect.w = ballSpawnRect.h = MathRound(BallRadius) * 8;
     ballSpawnRect.x = (ScreenWidth / 2) - (ballSpawnRect.w / 2);
     ballSpawnRect.y = ((ScreenHeight - HUDHeight) / 2) - (ballSpawnRect.h / 2);
-
-    uint8_t attemptsLeft = 32;
-    while (1) {
-        if (--attemptsLeft == 0) {
-            return;
-        }
-        
-        Powerups[id].x = selfRect.x = MathRandRangeI(PowerupSpawnRangeX[0], PowerupSpawnRangeX[1]);
-        Powerups[id].y = selfRect.y = MathRandRangeI(PowerupSpawnRangeY[0], PowerupSpawnRangeY[1]);
-//        Powerups[id].x = selfRect.x = ((PowerupSpawnRangeX[1] - PowerupSpawnRangeX[0]) / 2) + PowerupSpawnRangeX[0] + 100;
-//        Powerups[id].y = selfRect.y = ((PowerupSpawnRangeY[1] - PowerupSpawnRangeY[0]) / 2) + PowerupSpawnRangeY[0] + 40;
-//        Powerups[id].x = selfRect.x = ((PowerupSpawnRangeX[1] - PowerupSpawnRangeX[0]) / 2) + PowerupSpawnRangeX[0] + 40;
-//        Powerups[id].y = selfRect.y = ((PowerupSpawnRangeY[1] - PowerupSpawnRangeY[0]) / 2) + PowerupSpawnRangeY[0] + 100;
-        
-        if (SDL_HasIntersection(&selfRect, &ballSpawnRect)) {
-            // The Powerup is in the ball-spawning area.  Pick another spot, if possible!
-            continue;
-        }
-        
-        PowerupID collidingID;
-        for (collidingID = 0; collidingID < SDL_arraysize(Powerups); ++collidingID) {
-            if (Powerups[collidingID].type == PowerupType_Inactive) {
-                continue;   // Ignore inactive Powerup slots (implicitly-including the one at [id])!
-            }
-            otherRect.x = Powerups[collidingID].x - PowerupMargin;
-            otherRect.y = Powerups[collidingID].y - PowerupMargin;
-            if (SDL_HasIntersection(&selfRect, &otherRect)) {
-                // A collision was detected!
-                break;
-            }
+    spotRect.w = spotRect.h = PowerupSize;
+    
+    SDL_memset(spots->freeSpots, 0, sizeof(spots->freeSpots));
+    spots->freeCount = 0;
+    for (uint16_t spot = 0; spot < PowerupSpotCount; ++spot) {
+        spotRect.x = PowerupSpawnRangeX[0] + ((spot % PowerupSpotColumns) * PowerupSpotStep);
+        spotRect.y = PowerupSpawnRangeY[0] + ((spot / PowerupSpotColumns) * PowerupSpotStep);
+        spots->blockers[spot] = SDL_HasIntersection(&spotRect, &ballSpawnRect) ? 1 : 0;
+        if (spots->blockers[spot] == 0) {
+            spots->freeSpots[spot / 64] |= (1ull << (spot % 64));
+            ++spots->freeCount;
         }
-        if (collidingID >= SDL_arraysize(Powerups)) {
-            // A collision (with another Powerup) was *NOT* detected!
-            break;
+    }
+    for (uint16_t i = 0; i < numPowerups; ++i) {
+        if (powerups[i].type != PowerupType_Inactive) {
+            spots->Block(powerups[i].x, powerups[i].y, 1);
         }
     }
+}
+
+// PowerupRespawn -- activates a powerup, at a random, unblocked spot.  If
+//   there's no room for it, it stays inactive.
+static void PowerupRespawn(Powerup * powerups, uint16_t numPowerups, PowerupID id, PowerupSpots * spots, Rand * rand)
+{
+    if (id < 0 || id >= numPowerups) {
+        return;
+    }
+    
+    // An active powerup gets moved, so it stops blocking its old spot
+    if (powerups[id].type != PowerupType_Inactive) {
+        spots->Block(powerups[id].x, powerups[id].y, -1);
+        powerups[id].type = PowerupType_Inactive;
+    }
+    if (spots->freeCount == 0) {
+        return;
+    }
+    const uint16_t spot = spots->PickFree(MathRandRangeI(rand, 0, spots->freeCount - 1));
+    powerups[id].x = PowerupSpawnRangeX[0] + ((spot % PowerupSpotColumns) * PowerupSpotStep);
+    powerups[id].y = PowerupSpawnRangeY[0] + ((spot / PowerupSpotColumns) * PowerupSpotStep);
+    spots->Block(powerups[id].x, powerups[id].y, 1);
   
     // Mark the powerup as active
-    Powerups[id].type = (uint8_t) MathRandRangeI(1, PowerupTypeCount);
-//    Powerups[id].type = PowerupType_AddBall;
-//    Powerups[id].type = (uint8_t) MathRandRangeI(PowerupType_AddBall, PowerupType_RemoveBall);
+    powerups[id].type = (uint8_t) MathRandRangeI(rand, 1, PowerupTypeCount);
+//    powerups[id].type = PowerupType_AddBall;
+//    powerups[id].type = (uint8_t) MathRandRangeI(rand, PowerupType_AddBall, PowerupType_RemoveBall);
     
     // Give the powerup a life-time
-    Powerups[id].gameTicksLeft = MathRandRangeI(PowerupMinLifetime, PowerupMaxLifetime);
+    powerups[id].gameTicksLeft = MathRandRangeI(rand, TimingSecondsToTicks(PowerupMinLifetime), TimingSecondsToTicks(PowerupMaxLifetime));
 }
 
-static void PowerupDeactivate(PowerupID id)
+static void PowerupDeactivate(Powerup * powerups, uint16_t numPowerups, PowerupID id, PowerupSpots * spots, Rand * rand)
 {
-    if (id < 0 || id >= SDL_arraysize(Powerups)) {
+    if (id < 0 || id >= numPowerups) {
         return;
     }
 
-    Powerups[id].type = PowerupType_Inactive;
-    Powerups[id].gameTicksLeft = MathRandRangeI(PowerupMinLifetime, PowerupMaxLifetime);
+    if (powerups[id].type != PowerupType_Inactive) {
+        spots->Block(powerups[id].x, powerups[id].y, -1);
+    }
+    powerups[id].type = PowerupType_Inactive;
+    powerups[id].gameTicksLeft = MathRandRangeI(rand, TimingSecondsToTicks(PowerupMinLifetime), TimingSecondsToTicks(PowerupMaxLifetime));
+}
+
+// PowerupGrid -- uniform grid over the playfield, listing the active powerups
+//   that a ball might touch, by the cell that the ball's top-left corner is in.
+//   Each powerup gets listed in every cell that such a ball's corner could be
+//   in (its rect, grown up + left by BallSize), so one cell is all that a ball
+//   needs to look in.  Cells list powerups in increasing PowerupID order.
+static const uint16_t PowerupGridCellSize = 64;
+static const uint16_t PowerupGridColumns = (ScreenWidth + PowerupGridCellSize - 1) / PowerupGridCellSize;
+static const uint16_t PowerupGridRows = (ScreenHeight - HUDHeight + PowerupGridCellSize - 1) / PowerupGridCellSize;
+static const uint16_t PowerupGridCells = PowerupGridColumns * PowerupGridRows;
+static const uint8_t PowerupGridMaxCellsPerPowerup = 4;     // (BallSize + PowerupSize) <= PowerupGridCellSize, so 2 x 2 cells, at most
+struct PowerupGrid {
+    uint32_t cellStarts[PowerupGridCells + 1];  // cell C's powerups are at ids[cellStarts[C]] to ids[cellStarts[C + 1] - 1]
+    PowerupID * ids;                            // room for PowerupGridMaxCellsPerPowerup per powerup
+    
+    // CellAt -- gets the cell that a point is in; points off the grid use the nearest cell
+    static uint16_t CellAt(int x, int y) {
+        const int column = SDL_max(0, SDL_min(x, PowerupGridColumns * PowerupGridCellSize - 1)) / PowerupGridCellSize;
+        const int row = SDL_max(0, SDL_min(y, PowerupGridRows * PowerupGridCellSize - 1)) / PowerupGridCellSize;
+        return (uint16_t)((row * PowerupGridColumns) + column);
+    }
+    
+    // Find -- gets the powerups that a ball, whose rect's top-left is at (x, y), might touch
+    uint32_t Find(int x, int y, const PowerupID ** outIDs) const {
+        const uint16_t cell = CellAt(x, y);
+        *outIDs = ids + cellStarts[cell];
+        return cellStarts[cell + 1] - cellStarts[cell];
+    }
+};
+
+// PowerupGridBuild -- [re]lists all active powerups, in a grid; 'grid->ids' must
+//   have room for (numPowerups * PowerupGridMaxCellsPerPowerup) PowerupIDs
+static void PowerupGridBuild(PowerupGrid * grid, const Powerup * powerups, uint16_t numPowerups)
+{
+    // Count each cell's powerups, then turn the counts into starting offsets
+    SDL_memset(grid->cellStarts, 0, sizeof(grid->cellStarts));
+    for (uint16_t i = 0; i < numPowerups; ++i) {
+        if (powerups[i].type == PowerupType_Inactive) {
+            continue;
+        }
+        const uint16_t first = PowerupGrid::CellAt(powerups[i].x - BallSize + 1, powerups[i].y - BallSize + 1);
+        const uint16_t last = PowerupGrid::CellAt(powerups[i].x + PowerupSize - 1, powerups[i].y + PowerupSize - 1);
+        for (uint16_t row = first / PowerupGridColumns; row <= last / PowerupGridColumns; ++row) {
+            for (uint16_t column = first % PowerupGridColumns; column <= last % PowerupGridColumns; ++column) {
+                ++grid->cellStarts[(row * PowerupGridColumns) + column + 1];
+            }
+        }
+    }
+    for (uint16_t cell = 0; cell < PowerupGridCells; ++cell) {
+        grid->cellStarts[cell + 1] += grid->cellStarts[cell];
+    }
+    
+    // Fill in the cells, using cellStarts[C] as cell C's write position.  That
+    // leaves cellStarts[C] at cell C+1's start, so shift everything back by one.
+    for (uint16_t i = 0; i < numPowerups; ++i) {
+        if (powerups[i].type == PowerupType_Inactive) {
+            continue;
+        }
+        const uint16_t first = PowerupGrid::CellAt(powerups[i].x - BallSize + 1, powerups[i].y - BallSize + 1);
+        const uint16_t last = PowerupGrid::CellAt(powerups[i].x + PowerupSize - 1, powerups[i].y + PowerupSize - 1);
+        for (uint16_t row = first / PowerupGridColumns; row <= last / PowerupGridColumns; ++row) {
+            for (uint16_t column = first % PowerupGridColumns; column <= last % PowerupGridColumns; ++column) {
+                grid->ids[grid->cellStarts[(row * PowerupGridColumns) + column]++] = i;
+            }
+        }
+    }
+    for (uint16_t cell = PowerupGridCells; cell > 0; --cell) {
+        grid->cellStarts[cell] = grid->cellStarts[cell - 1];
+    }
+    grid->cellStarts[0] = 0;
 }
 
 
@@ -754,23 +1633,23 @@ static void PowerupDeactivate(PowerupID id)
 //    #####   ## #  ####    ###   #      ####  
 //                                             
 #pragma mark - Lasers
-static const float LaserMagnitudeStep = -0.19f;      // Adjust laser magnitude by this much, per game-tick
-static const float LaserInitialMagnitude = 7.f;     // Default laser magnitutde; TODO: make this adjustable, per-paddle (for laser-upgrades)
-static const uint8_t LaserCutInterval = 3;          // Only perform cuts once per this number of game-ticks
+static const float LaserMagnitudeStep = -19.f;      // Adjust laser magnitude by this much, per second
+static const Real LaserInitialMagnitude = 7.f;      // Default laser magnitutde; TODO: make this adjustable, per-paddle (for laser-upgrades)
+static const float LaserCutInterval = 0.03f;        // Only perform cuts once per this number of seconds
 struct Laser {
-    float cy;                   // laser center, on Y axis
-    float magnitude;            // laser height = magnitude * 2.f
+    Real cy;                    // laser center, on Y axis
+    Real magnitude;             // laser height = magnitude * 2.f
     uint8_t gameTicksUntilCut;  // number of game-ticks to wait before cutting paddle; default is set via 'LaserCutInterval'
     
     // GetRect -- try getting laser's SDL_Rect, in Screen coordinates
     //   Returns 0 on success, non-zero on failure.  Result rect will be output to 'r'.
-    uint8_t GetRect(SDL_Rect * r, uint8_t paddleIndex) const {
+    uint8_t GetRect(SDL_Rect * r, uint8_t paddleIndex, const Paddle * paddles) const {
         if (magnitude == 0.f) {
             return -1;
         }
         switch (paddleIndex) {
-            case 0:  r->x = Paddles[0].Right();  r->w = ScreenWidth - Paddles[paddleIndex].Right();  break;
-            case 1:  r->x = 0;                   r->w = Paddles[paddleIndex].Left();                 break;
+            case 0:  r->x = paddles[0].Right();  r->w = ScreenWidth - paddles[paddleIndex].Right();  break;
+            case 1:  r->x = 0;                   r->w = paddles[paddleIndex].Left();                 break;
             default:
                 return -1;
         }
@@ -778,7 +1657,7 @@ struct Laser {
         r->h = MathRound(magnitude * 2.f);
         return 0;
     }
-} Lasers[2];
+};
 
 
 //
@@ -791,14 +1670,247 @@ struct Laser {
 //
 #pragma mark - Scoring
 
-static uint16_t Scores[2];
 static int16_t ScoreZoneWidth = 4;
 static SDL_Rect ScoreZones[] = {
     { 0,                            0, ScoreZoneWidth, ScreenHeight - HUDHeight },
     { ScreenWidth - ScoreZoneWidth, 0, ScoreZoneWidth, ScreenHeight - HUDHeight }
 };
-static uint16_t GameTicksToNextRound = 0;
-static const uint16_t GameTicksToNextRoundDefault = 100;
+static const float GameTimeToNextRoundDefault = 1.f;   // number of seconds to wait, between rounds
+
+
+//
+//     ####                               ####    #               #
+//    #       ####  ## #    ###          #       ####   ####   ####    ###
+//    #  ##  #   #  # # #  #####          ###     #    #   #    #     #####
+//    #   #  #  ##  # # #  #                 #    #    #  ##    #     #
+//     ####   ## #  #   #   ###          ####      ##   ## #     ##    ###
+//
+// Everything needed to run one match.  Any number of matches may exist at
+// once, and each one may be updated on its own thread.
+//
+#pragma mark - Game State
+
+struct GameState {
+    Ball * balls;                   // 'ballCapacity' balls, active or not
+    uint16_t ballCapacity;
+    uint16_t activeBallCount;       // number of balls that aren't BallTypeInactive
+    uint16_t freeBallSearchStart;   // all balls before this one are active
+    Paddle paddles[PaddleCount];
+    Powerup * powerups;             // 'powerupCapacity' powerups, active or not
+    uint16_t powerupCapacity;
+    PowerupGrid powerupGrid;        // active powerups, by location
+    SDL_bool powerupGridIsStale;    // SDL_TRUE if powerups have [de]spawned since powerupGrid was last built
+    SDL_bool usePowerupGrid;        // SDL_FALSE to test each ball against every powerup (for benchmarking the grid)
+    PowerupSpots powerupSpots;      // where powerups can spawn
+    struct GameBallPool * ballPool; // threads to update balls with, in parallel, if any; see GameBallPool
+    SDL_bool powerupSpotsAreStale;  // SDL_TRUE if powerupSpots needs rebuilding, before spawning more powerups
+    Laser lasers[PaddleCount];
+    uint16_t scores[PaddleCount];
+    uint16_t ticksToNextRound;      // number of game-ticks to wait before starting a new round; 0 while a round is in progress
+    Rand rand;                      // random number generator for the match; seed via GameSeed()
+    uint8_t aiPaddles;              // 1 bit per paddle that the AI controls (via GameInputFromAI()); set before GameInit()
+    uint32_t powerupHits[PowerupType_LAST]; // number of ball bounces off of each type of powerup, for stats; not part of the match's state
+};
+
+// The match that gets played in the app's window
+static GameState Game;
+
+// GameStateDestroy -- frees a match's resources
+static void GameStateDestroy(GameState * game)
+{
+    SDL_free(game->balls);
+    SDL_free(game->powerups);
+    SDL_free(game->powerupGrid.ids);
+    SDL_memset(game, 0, sizeof(GameState));
+}
+
+// GameStateCreate -- allocates a match's resources, with room for the given
+//   number of balls + powerups; call once, before GameSeed() and GameInit()
+static SDL_bool GameStateCreate(GameState * game, uint16_t ballCapacity, uint16_t powerupCapacity)
+{
+    SDL_memset(game, 0, sizeof(GameState));
+    if (ballCapacity == 0 || powerupCapacity == 0 || powerupCapacity > INT16_MAX) {
+        SDL_Log("%s, invalid capacity: %u balls, %u powerups", __FUNCTION__, (unsigned)ballCapacity, (unsigned)powerupCapacity);
+        return SDL_FALSE;
+    }
+    game->balls = (Ball *) SDL_calloc(ballCapacity, sizeof(Ball));
+    game->powerups = (Powerup *) SDL_calloc(powerupCapacity, sizeof(Powerup));
+    game->powerupGrid.ids = (PowerupID *) SDL_calloc(powerupCapacity * PowerupGridMaxCellsPerPowerup, sizeof(PowerupID));
+    if ( ! game->balls || ! game->powerups || ! game->powerupGrid.ids) {
+        SDL_Log("%s, out of memory", __FUNCTION__);
+        GameStateDestroy(game);
+        return SDL_FALSE;
+    }
+    game->ballCapacity = ballCapacity;
+    game->powerupCapacity = powerupCapacity;
+    game->usePowerupGrid = SDL_TRUE;
+    game->powerupSpotsAreStale = SDL_TRUE;
+    return SDL_TRUE;
+}
+
+// GameStateReset -- returns a match to how GameStateCreate() left it, keeping
+//   its allocations and settings (usePowerupGrid, aiPaddles, ballPool).  (GameInit()
+//   only resets what a new round needs to.)
+static void GameStateReset(GameState * game)
+{
+    SDL_memset(game->balls, 0, game->ballCapacity * sizeof(Ball));
+    game->activeBallCount = 0;
+    game->freeBallSearchStart = 0;
+    SDL_memset(game->paddles, 0, sizeof(game->paddles));
+    SDL_memset(game->powerups, 0, game->powerupCapacity * sizeof(Powerup));
+    game->powerupGridIsStale = SDL_TRUE;
+    game->powerupSpotsAreStale = SDL_TRUE;
+    SDL_memset(game->lasers, 0, sizeof(game->lasers));
+    SDL_memset(game->scores, 0, sizeof(game->scores));
+    game->ticksToNextRound = 0;
+    SDL_memset(&game->rand, 0, sizeof(game->rand));
+    SDL_memset(game->powerupHits, 0, sizeof(game->powerupHits));
+}
+
+// GamePowerupSpotsRefresh -- rebuilds a match's powerupSpots, if they're stale
+static void GamePowerupSpotsRefresh(GameState * game)
+{
+    if (game->powerupSpotsAreStale) {
+        PowerupSpotsBuild(&game->powerupSpots, game->powerups, game->powerupCapacity);
+        game->powerupSpotsAreStale = SDL_FALSE;
+    }
+}
+
+// GameBallSpawn -- [re]spawns a ball, active or not
+static void GameBallSpawn(GameState * game, uint16_t ballIndex)
+{
+    if (game->balls[ballIndex].type == BallTypeInactive) {
+        ++game->activeBallCount;
+    }
+    BallRespawn(&game->balls[ballIndex], &game->rand);
+}
+
+// GameBallRemove -- deactivates a ball, if it isn't already
+static void GameBallRemove(GameState * game, uint16_t ballIndex)
+{
+    if (game->balls[ballIndex].type != BallTypeInactive) {
+        --game->activeBallCount;
+        game->balls[ballIndex].type = BallTypeInactive;
+        game->freeBallSearchStart = SDL_min(game->freeBallSearchStart, ballIndex);
+    }
+}
+
+// GameBallFindFree -- gets the first inactive ball, or ballCapacity if all are active
+static uint16_t GameBallFindFree(GameState * game)
+{
+    while (game->freeBallSearchStart < game->ballCapacity &&
+           game->balls[game->freeBallSearchStart].type != BallTypeInactive)
+    {
+        ++game->freeBallSearchStart;
+    }
+    return game->freeBallSearchStart;
+}
+
+
+//
+//     ####                                  ####                              #              #
+//    #       ####  ## #    ###             #      # ##    ####  ####    ####  # ##    ###   ####    ####
+//    #  ##  #   #  # # #  #####             ###   ##  #  #   #  #   #  ###    ##  #  #   #   #     ###
+//    #   #  #  ##  # # #  #                    #  #   #  #  ##  #   #    ###  #   #  #   #   #       ###
+//     ####   ## #  #   #   ###             ####   #   #   ## #  ####   ####   #   #   ###     ##   ####
+//                                                               #
+//
+// Flat copies of a match's complete state, cheap enough to save and restore
+// every game-tick.  They hold no pointers, so they can be memcpy'd, or stored
+// in arrays.  They're native-endian and build-specific, so they aren't saved
+// to files; replays rebuild theirs after loading.
+//
+#pragma mark - Game Snapshots
+
+// GamePaddleSnapshot -- the parts of a Paddle that change during a match.  The
+//   rest (its X, bounce direction, ball type, and key bindings) are set up
+//   once, by GameInit() and the app, and are left alone by restores.
+struct GamePaddleSnapshot {
+    Real y;
+    Real vy;
+    int16_t cutTop;
+    int16_t cutBottom;
+    uint16_t laserRechargeTicks;
+    uint8_t numCuts;
+    PaddleCutRows cuts[PaddleMaxCuts];
+};
+
+struct GameSnapshot {
+    Ball balls[BallDefaultCapacity];
+    Powerup powerups[PowerupDefaultCapacity];
+    GamePaddleSnapshot paddles[PaddleCount];
+    Laser lasers[PaddleCount];
+    uint16_t activeBallCount;
+    uint16_t freeBallSearchStart;
+    uint16_t scores[PaddleCount];
+    uint16_t ticksToNextRound;
+    Rand rand;
+};
+
+// GameSnapshotSave -- copies a match's complete state into a snapshot; only
+//   matches with the default ball and powerup capacities can be snapshotted
+static SDL_bool GameSnapshotSave(const GameState * game, GameSnapshot * snapshot)
+{
+    if (game->ballCapacity != BallDefaultCapacity || game->powerupCapacity != PowerupDefaultCapacity) {
+        SDL_Log("%s, can't snapshot a match with capacity for %u balls, %u powerups",
+                __FUNCTION__, (unsigned)game->ballCapacity, (unsigned)game->powerupCapacity);
+        return SDL_FALSE;
+    }
+    SDL_memcpy(snapshot->balls, game->balls, sizeof(snapshot->balls));
+    SDL_memcpy(snapshot->powerups, game->powerups, sizeof(snapshot->powerups));
+    for (uint8_t i = 0; i < PaddleCount; ++i) {
+        const Paddle * paddle = &game->paddles[i];
+        GamePaddleSnapshot * paddleSnapshot = &snapshot->paddles[i];
+        paddleSnapshot->y = paddle->y;
+        paddleSnapshot->vy = paddle->vy;
+        paddleSnapshot->cutTop = paddle->cutTop;
+        paddleSnapshot->cutBottom = paddle->cutBottom;
+        paddleSnapshot->laserRechargeTicks = paddle->laserRechargeTicks;
+        paddleSnapshot->numCuts = paddle->numCuts;
+        SDL_memcpy(paddleSnapshot->cuts, paddle->cuts, sizeof(paddleSnapshot->cuts));
+    }
+    SDL_memcpy(snapshot->lasers, game->lasers, sizeof(snapshot->lasers));
+    SDL_memcpy(snapshot->scores, game->scores, sizeof(snapshot->scores));
+    snapshot->activeBallCount = game->activeBallCount;
+    snapshot->freeBallSearchStart = game->freeBallSearchStart;
+    snapshot->ticksToNextRound = game->ticksToNextRound;
+    snapshot->rand = game->rand;
+    return SDL_TRUE;
+}
+
+// GameSnapshotRestore -- overwrites a match's complete state with a snapshot's;
+//   the match must have been created with the default ball and powerup
+//   capacities, and set up by GameInit(), for its paddles' fixed fields
+static SDL_bool GameSnapshotRestore(GameState * game, const GameSnapshot * snapshot)
+{
+    if (game->ballCapacity != BallDefaultCapacity || game->powerupCapacity != PowerupDefaultCapacity) {
+        SDL_Log("%s, can't restore a snapshot into a match with capacity for %u balls, %u powerups",
+                __FUNCTION__, (unsigned)game->ballCapacity, (unsigned)game->powerupCapacity);
+        return SDL_FALSE;
+    }
+    SDL_memcpy(game->balls, snapshot->balls, sizeof(snapshot->balls));
+    SDL_memcpy(game->powerups, snapshot->powerups, sizeof(snapshot->powerups));
+    for (uint8_t i = 0; i < PaddleCount; ++i) {
+        Paddle * paddle = &game->paddles[i];
+        const GamePaddleSnapshot * paddleSnapshot = &snapshot->paddles[i];
+        paddle->y = paddleSnapshot->y;
+        paddle->vy = paddleSnapshot->vy;
+        paddle->cutTop = paddleSnapshot->cutTop;
+        paddle->cutBottom = paddleSnapshot->cutBottom;
+        paddle->laserRechargeTicks = paddleSnapshot->laserRechargeTicks;
+        paddle->numCuts = paddleSnapshot->numCuts;
+        SDL_memcpy(paddle->cuts, paddleSnapshot->cuts, sizeof(paddle->cuts));
+    }
+    SDL_memcpy(game->lasers, snapshot->lasers, sizeof(snapshot->lasers));
+    SDL_memcpy(game->scores, snapshot->scores, sizeof(snapshot->scores));
+    game->activeBallCount = snapshot->activeBallCount;
+    game->freeBallSearchStart = snapshot->freeBallSearchStart;
+    game->ticksToNextRound = snapshot->ticksToNextRound;
+    game->rand = snapshot->rand;
+    game->powerupGridIsStale = SDL_TRUE;
+    game->powerupSpotsAreStale = SDL_TRUE;
+    return SDL_TRUE;
+}
 
 
 //
@@ -812,6 +1924,44 @@ static const uint16_t GameTicksToNextRoundDefault = 100;
 //
 #pragma mark - Game Preload
 
+// GameBackground -- the play area's background (tiles, plus paddle-bars),
+//   composed once, by GamePreload(), then copied under each drawn frame
+static SDL_Surface * GameBackground = NULL;
+static SDL_bool GameBackgroundCompose()
+{
+    GameBackground = SDL_CreateRGBSurface(0, ScreenWidth, ScreenHeight - HUDHeight, 32, ImageRMask, ImageGMask, ImageBMask, ImageAMask);
+    if ( ! GameBackground) {
+        SDL_Log("%s, SDL_CreateRGBSurface failed: %s", __FUNCTION__, SDL_GetError());
+        return SDL_FALSE;
+    }
+    
+    // Tiles
+    SDL_Rect r;
+    r.w = Images[ImageIDBackgroundTile]->w;
+    r.h = Images[ImageIDBackgroundTile]->h;
+    for (uint16_t y = 0; y < GameBackground->h; y += r.h) {
+        for (uint16_t x = 0; x < GameBackground->w; x += r.w) {
+            r.x = x;
+            r.y = y;
+            SDL_BlitSurface(Images[ImageIDBackgroundTile], NULL, GameBackground, &r);
+        }
+    }
+    
+    // Paddle-Bars
+    r.w = Images[ImageIDBackgroundPaddleBar]->w;
+    r.h = Images[ImageIDBackgroundPaddleBar]->h;
+    for (uint8_t i = 0; i < PaddleCount; ++i) {
+        r.x = PaddleXs[i] + (PaddleWidth / 2) - (r.w / 2);
+        for (int16_t y = 0; y < GameBackground->h; y += r.h) {
+            r.y = y;
+            SDL_BlitSurface(Images[ImageIDBackgroundPaddleBar], NULL, GameBackground, &r);
+        }
+    }
+    
+    SDL_SetSurfaceBlendMode(GameBackground, SDL_BLENDMODE_NONE);
+    return SDL_TRUE;
+}
+
 static SDL_bool GamePreload()
 {
     if ( ! (
@@ -819,8 +1969,6 @@ static SDL_bool GamePreload()
         ImageLoad(&ImageIDBallBlue, "Data/Images/BallBlue.png") &&
         ImageLoad(&ImageIDBallNoPlayer, "Data/Images/BallNoPlayer.png") &&
         ImageLoad(&ImageIDBallRed, "Data/Images/BallRed.png") &&
-        ImageCreate(&ImageIDPaddleBlue, PaddleWidth, PaddleMaxH) &&
-        ImageCreate(&ImageIDPaddleRed, PaddleWidth, PaddleMaxH) &&
         ImageLoad(&ImageIDPaddleBlueTemplate, "Data/Images/PaddleBlue.png") &&
         ImageLoad(&ImageIDPaddleRedTemplate, "Data/Images/PaddleRed.png") &&
         ImageLoad(&ImageIDBackgroundTile, "Data/Images/BackgroundTile.png") &&
@@ -835,6 +1983,33 @@ static SDL_bool GamePreload()
     }
     
     SDL_SetSurfaceBlendMode(Images[ImageIDBackgroundTile], SDL_BLENDMODE_NONE);     // prevent background tile from using CPU-costly blend, important on Emscripten
+    if ( ! GameBackgroundCompose()) {
+        return SDL_FALSE;
+    }
+    
+    // Collision masks.  Balls collide wherever they aren't fully transparent;
+    // paddles collide only where they're fully opaque.
+    uint32_t paddleMask[PaddleMaxH];
+    if ( ! (
+        ImageGetRowMasks(ImageIDBallNoPlayer, 0x01, BallMasks[BallTypeNoPlayer], BallSize) &&
+        ImageGetRowMasks(ImageIDBallBlue, 0x01, BallMasks[BallTypeBlue], BallSize) &&
+        ImageGetRowMasks(ImageIDBallRed, 0x01, BallMasks[BallTypeRed], BallSize)
+    ))
+    {
+        return SDL_FALSE;
+    }
+    for (uint8_t i = 0; i < PaddleCount; ++i) {
+        const ImageID templateID = (i == 0) ? ImageIDPaddleBlueTemplate : ImageIDPaddleRedTemplate;
+        if (Images[templateID]->w > 16 || ! ImageGetRowMasks(templateID, 0xff, paddleMask, PaddleMaxH)) {
+            return SDL_FALSE;
+        }
+        for (uint16_t y = 0; y < PaddleMaxH; ++y) {
+            PaddleTemplateMasks[i][y] = (uint16_t) paddleMask[y];
+            if (paddleMask[y]) {
+                PaddleTemplateRows[i][y / 64] |= (1ull << (y % 64));
+            }
+        }
+    }
     
     return SDL_TRUE;
 }
@@ -858,69 +2033,86 @@ enum : uint8_t {
     GAME_INIT_NEXT_ROUND                = 0x0F
 };
 
+// GameSeed -- seeds the match's random number generator.  The same seed, plus
+//   the same per-tick input, will always reproduce the same match.
+static void GameSeed(GameState * game, uint64_t seed)
+{
+    game->rand.Seed(seed);
+}
+
 // GameInit -- [re]initializes a new round of gameplay
-static void GameInit(uint8_t initFlags)
+static void GameInit(GameState * game, uint8_t initFlags)
 {
     // Scoring
     if ( ! (initFlags & GAME_INIT_KEEP_SCORES)) {
-        SDL_memset(&Scores, 0, sizeof(Scores));
+        SDL_memset(game->scores, 0, sizeof(game->scores));
     }
-    GameTicksToNextRound = 0;
+    game->ticksToNextRound = 0;
 
     // Paddle position
-    for (uint8_t i = 0; i < SDL_arraysize(Paddles); ++i) {
-        Paddles[i].x = PaddleXs[i];
+    for (uint8_t i = 0; i < SDL_arraysize(game->paddles); ++i) {
+        game->paddles[i].x = PaddleXs[i];
         if ( ! (initFlags & GAME_INIT_KEEP_PADDLE_STATE)) {
-            Paddles[i].y = (ScreenHeight - HUDHeight - PaddleMaxH) / 2.f;
-            Paddles[i].vy = 0.f;
-            Paddles[i].laserRechargeTicks = 0;
+            game->paddles[i].y = (ScreenHeight - HUDHeight - PaddleMaxH) / 2.f;
+            game->paddles[i].vy = 0.f;
+            game->paddles[i].laserRechargeTicks = 0;
         }
     }
 
-    Paddles[0].ballBounceDirection = 1;
-    Paddles[0].ballType = BallTypeBlue;
+    game->paddles[0].ballBounceDirection = 1;
+    game->paddles[0].ballType = BallTypeBlue;
 
-    Paddles[1].ballBounceDirection = -1;
-    Paddles[1].ballType = BallTypeRed;
+    game->paddles[1].ballBounceDirection = -1;
+    game->paddles[1].ballType = BallTypeRed;
 
     // Paddle contents
-    for (uint8_t i = 0; i < SDL_arraysize(Paddles); ++i) {
+    for (uint8_t i = 0; i < SDL_arraysize(game->paddles); ++i) {
         if ((!(initFlags & GAME_INIT_ONLY_HEAL_DEAD_PADDLES)) ||
-            (Paddles[i].cutTop >= Paddles[i].cutBottom))        // is the paddle completely dead?
+            (game->paddles[i].cutTop >= game->paddles[i].cutBottom))        // is the paddle completely dead?
         {
-            PaddleHeal(i);
+            PaddleHeal(&game->paddles[i], i);
         }
     }
     
-    // Paddle input keys
-    // TODO: set to SDL_SCANCODE_UNKNOWN for AI control?
-    Paddles[0].keyUp = SDL_SCANCODE_LSHIFT;
-    Paddles[0].keyDown = SDL_SCANCODE_LCTRL;
-    Paddles[0].keyLaser = SDL_SCANCODE_Z;
-    Paddles[1].keyUp = SDL_SCANCODE_RETURN;
-    Paddles[1].keyDown = SDL_SCANCODE_RSHIFT;
-    Paddles[1].keyLaser = SDL_SCANCODE_SLASH;
+    // Paddle input keys.  AI-controlled paddles get none, so that the
+    // keyboard can't fight the AI over them.
+    game->paddles[0].keyUp = SDL_SCANCODE_LSHIFT;
+    game->paddles[0].keyDown = SDL_SCANCODE_LCTRL;
+    game->paddles[0].keyLaser = SDL_SCANCODE_Z;
+    game->paddles[1].keyUp = SDL_SCANCODE_RETURN;
+    game->paddles[1].keyDown = SDL_SCANCODE_RSHIFT;
+    game->paddles[1].keyLaser = SDL_SCANCODE_SLASH;
+    for (uint8_t i = 0; i < SDL_arraysize(game->paddles); ++i) {
+        if (game->aiPaddles & (1 << i)) {
+            game->paddles[i].keyUp = SDL_SCANCODE_UNKNOWN;
+            game->paddles[i].keyDown = SDL_SCANCODE_UNKNOWN;
+            game->paddles[i].keyLaser = SDL_SCANCODE_UNKNOWN;
+        }
+    }
     
     // Reset lasers
-    for (uint8_t i = 0; i < SDL_arraysize(Lasers); ++i) {
-        Lasers[i].magnitude = 0.f;
+    for (uint8_t i = 0; i < SDL_arraysize(game->lasers); ++i) {
+        game->lasers[i].magnitude = 0.f;
     }
 
     // Reset powerups
     if ( ! (initFlags & GAME_INIT_KEEP_POWERUPS)) {
-        SDL_memset(Powerups, 0, sizeof(Powerups));
-        uint8_t numPowerupsToSpawn = MathRandRangeI(0, 4);
-        for (uint8_t i = 0; i < SDL_arraysize(Powerups); ++i) {
+        SDL_memset(game->powerups, 0, game->powerupCapacity * sizeof(Powerup));
+        game->powerupSpotsAreStale = SDL_TRUE;
+        GamePowerupSpotsRefresh(game);
+        uint8_t numPowerupsToSpawn = MathRandRangeI(&game->rand, 0, 4);
+        for (uint16_t i = 0; i < game->powerupCapacity; ++i) {
             if (i < numPowerupsToSpawn) {
-                PowerupRespawn(i);
+                PowerupRespawn(game->powerups, game->powerupCapacity, i, &game->powerupSpots, &game->rand);
             } else {
-                PowerupDeactivate(i);
+                PowerupDeactivate(game->powerups, game->powerupCapacity, i, &game->powerupSpots, &game->rand);
             }
         }
+        game->powerupGridIsStale = SDL_TRUE;
     }
     
     // Spawn a ball
-    BallRespawn(0);
+    GameBallSpawn(game, 0);
 }
 
 
@@ -934,7 +2126,7 @@ static void GameInit(uint8_t initFlags)
 #pragma mark - Game Events
 
 // GameEventHandler -- processes game-specific SDL_Events, *RARELY-USED*
-//   Most input is handled by inspecting current input state from inside GameUpdate().
+//   Most input is handled by sampling the keyboard once per frame, via GameInputFromKeyboard().
 static void GameEventHandler(const SDL_Event * event)
 {
 #if DEBUG_KEYS
@@ -942,7 +2134,7 @@ static void GameEventHandler(const SDL_Event * event)
         case SDL_KEYDOWN: {
             switch (event->key.keysym.sym) {
                 case SDLK_r: {
-                    GameInit(GAME_INIT_DEFAULT);
+                    GameInit(&Game, GAME_INIT_DEFAULT);
                 } break;
             }
         } break;
@@ -951,6 +2143,173 @@ static void GameEventHandler(const SDL_Event * event)
 }
 
 
+//
+//     ####                               ###                          #
+//    #       ####  ## #    ###            #    # ##   ####   #   #   ####
+//    #  ##  #   #  # # #  #####           #    ##  #  #   #  #   #    #
+//    #   #  #  ##  # # #  #               #    #   #  #   #  #  ##    #
+//     ####   ## #  #   #   ###           ###   #   #  ####    ## #     ##
+//                                                     #
+//
+// Per-tick input, for all paddles.  GameUpdate() only ever sees these bits,
+// which may come from the keyboard, a script, a replay, an AI, the network, etc.
+//
+#pragma mark - Game Input
+
+enum : uint8_t {
+    GAME_INPUT_UP       = (1 << 0),
+    GAME_INPUT_DOWN     = (1 << 1),
+    GAME_INPUT_LASER    = (1 << 2),
+    GAME_INPUT_PADDLE   = 0x07          // mask for all of one paddle's input bits
+};
+static const uint8_t GameInputBitsPerPaddle = 3;
+
+struct GameInput {
+    uint8_t bits;   // GameInputBitsPerPaddle bits per paddle; paddle 0 in the lowest bits
+    
+    // Get -- gets one paddle's GAME_INPUT_* bits
+    uint8_t Get(uint8_t paddleIndex) const {
+        return (bits >> (paddleIndex * GameInputBitsPerPaddle)) & GAME_INPUT_PADDLE;
+    }
+    
+    // Set -- replaces one paddle's GAME_INPUT_* bits
+    void Set(uint8_t paddleIndex, uint8_t paddleBits) {
+        const uint8_t shift = paddleIndex * GameInputBitsPerPaddle;
+        bits = (bits & ~(GAME_INPUT_PADDLE << shift)) | ((paddleBits & GAME_INPUT_PADDLE) << shift);
+    }
+};
+
+// GameInputFromKeyboard -- fills a GameInput from SDL's current keyboard state, using a match's key bindings
+static GameInput GameInputFromKeyboard(const GameState * game)
+{
+    GameInput input = {0};
+    const Uint8 * keyState = SDL_GetKeyboardState(NULL);
+    for (uint8_t i = 0; i < SDL_arraysize(game->paddles); ++i) {
+        input.Set(i,
+            (keyState[game->paddles[i].keyUp]    ? GAME_INPUT_UP    : 0) |
+            (keyState[game->paddles[i].keyDown]  ? GAME_INPUT_DOWN  : 0) |
+            (keyState[game->paddles[i].keyLaser] ? GAME_INPUT_LASER : 0));
+    }
+    return input;
+}
+
+
+//
+//     ####                                #     ###
+//    #       ####  ## #    ###           # #     #
+//    #  ##  #   #  # # #  #####         #   #    #
+//    #   #  #  ##  # # #  #             #####    #
+//     ####   ## #  #   #   ###          #   #   ###
+//
+// Computer-controlled paddles.  Each game-tick, an AI paddle picks the ball
+// that will reach it soonest, works out where that ball will be when it gets
+// there (bouncing it off of the top and bottom walls, as Ball::MovePart()
+// does), then steers towards that spot.  Predictions are made from scratch,
+// with a handful of steps per ball, rather than by simulating ahead, so
+// AI-vs-AI matches still run at close to full speed, headless.  Powerups,
+// paddles, and other balls aren't predicted for.
+//
+#pragma mark - Game AI
+
+static const Real AIPaddleDeadZone = 4.f;           // AI paddles stop steering once this close (in pixels) to where they're headed
+static const uint8_t AIMaxPredictedBounces = 16;    // most wall-bounces to follow a ball through; any further ones get ignored
+
+// GameAIPredictBallY -- predicts a ball's center Y, 'ticks' game-ticks from now
+static Real GameAIPredictBallY(const Ball * ball, Real ticks)
+{
+    const Real top = BallRadius;
+    const Real bottom = Real(ScreenHeight - HUDHeight) - BallRadius;
+    const Real chop = TimingPerTick(BallChopVelocityY);
+    Real y = ball->cy;
+    Real vy = ball->vy;
+    for (uint8_t i = 0; (i < AIMaxPredictedBounces) && (vy != Real(0.f)); ++i) {
+        const Real wall = (vy > Real(0.f)) ? bottom : top;
+        const Real ticksToWall = (wall - y) / vy;
+        if (ticksToWall >= ticks) {
+            break;
+        }
+        
+        // Bounce, then chop, as per Ball::ChopVY()
+        y = wall;
+        ticks -= ticksToWall;
+        vy = SDL_max(-chop, SDL_min(chop, -vy));
+    }
+    return y + (vy * ticks);
+}
+
+// GameAIPaddleInput -- decides on one AI paddle's GAME_INPUT_* bits, for the next game-tick
+static uint8_t GameAIPaddleInput(const GameState * game, uint8_t paddleIndex)
+{
+    const Paddle * paddle = &game->paddles[paddleIndex];
+    if (paddle->cutTop >= paddle->cutBottom) {
+        return 0;   // nothing left to steer
+    }
+    
+    // Head for wherever the soonest-arriving ball will cross the paddle's
+    // face, or back to the middle, if no balls are on their way
+    const Real faceX = (paddle->ballBounceDirection > 0) ? (Real(paddle->Right()) + BallRadius) : (Real(paddle->Left()) - BallRadius);
+    const Ball * incoming = NULL;
+    Real soonest = 0.f;
+    for (uint16_t i = 0; i < game->ballCapacity; ++i) {
+        const Ball * ball = &game->balls[i];
+        if (ball->type == BallTypeInactive || (ball->vx * Real(paddle->ballBounceDirection)) >= Real(0.f)) {
+            continue;
+        }
+        const Real ticks = (faceX - ball->cx) / ball->vx;
+        if (ticks >= Real(0.f) && ( ! incoming || ticks < soonest)) {
+            incoming = ball;
+            soonest = ticks;
+        }
+    }
+    const Real targetY = incoming ? GameAIPredictBallY(incoming, soonest) : (Real(ScreenHeight - HUDHeight) / Real(2.f));
+    
+    // Steer the middle of what's left of the paddle towards the target,
+    // letting go early enough to coast to a stop there.  (Let-go paddles slow
+    // down exactly as fast as they speed up.)
+    const Real middle = paddle->Top() + (Real(paddle->cutTop + paddle->cutBottom) / Real(2.f));
+    const Real distance = targetY - middle;
+    const Real vStep = TimingPerTickPerTick(PaddleVStep);
+    const Real stoppingDistance = (paddle->vy * paddle->vy) / (vStep * Real(2.f));
+    uint8_t bits = 0;
+    if (distance > AIPaddleDeadZone && ! (paddle->vy > Real(0.f) && stoppingDistance >= distance)) {
+        bits |= GAME_INPUT_DOWN;
+    } else if (distance < -AIPaddleDeadZone && ! (paddle->vy < Real(0.f) && stoppingDistance >= -distance)) {
+        bits |= GAME_INPUT_UP;
+    }
+    
+    // Fire the laser whenever it would hit what's left of another paddle:
+    // an uncut row, between its solid edges, within the laser's initial
+    // height.  Lasers come out of the paddle's middle.
+    if (paddle->laserRechargeTicks == 0 && game->lasers[paddleIndex].magnitude == Real(0.f)) {
+        for (uint8_t j = 0; j < SDL_arraysize(game->paddles); ++j) {
+            const Paddle * other = &game->paddles[j];
+            if (j == paddleIndex) {
+                continue;
+            }
+            const int16_t laserTop = (int16_t)(MathRound(middle - LaserInitialMagnitude) - MathRound(other->Top()));
+            const int16_t top = SDL_max(laserTop, other->cutTop);
+            const int16_t bottom = SDL_min((int16_t)(laserTop + MathRound(LaserInitialMagnitude * Real(2.f))), other->cutBottom);
+            int16_t uncutEnd;
+            if (top < bottom && other->FindUncutRows(top, &uncutEnd) < bottom) {
+                bits |= GAME_INPUT_LASER;
+            }
+        }
+    }
+    return bits;
+}
+
+// GameInputFromAI -- replaces the input for a match's AI-controlled paddles (see GameState::aiPaddles) with the AI's
+static GameInput GameInputFromAI(const GameState * game, GameInput input)
+{
+    for (uint8_t i = 0; i < SDL_arraysize(game->paddles); ++i) {
+        if (game->aiPaddles & (1 << i)) {
+            input.Set(i, GameAIPaddleInput(game, i));
+        }
+    }
+    return input;
+}
+
+
 //   
 //     ####                               ###           ##     ##      #             #                        
 //    #       ####  ## #    ###          #   #   ###     #      #            ####          ###   # ##    #### 
@@ -961,12 +2320,139 @@ static void GameEventHandler(const SDL_Event * event)
 #pragma mark - Game Collisions
 
 // GameIsBallPaddleCollision -- determines if a paddle and a ball are colliding
-static SDL_bool GameIsBallPaddleCollision(uint8_t ballIndex, uint8_t paddleIndex)
+static SDL_bool GameIsBallPaddleCollision(const GameState * game, uint16_t ballIndex, uint8_t paddleIndex)
+{
+    // First, check to see if the ball + paddle's rects match up
+    SDL_Rect ballRect, paddleRect, intersection;
+    game->balls[ballIndex].GetRect(&ballRect);
+    game->paddles[paddleIndex].GetRect(&paddleRect);
+    if ( ! SDL_IntersectRect(&ballRect, &paddleRect, &intersection)) {
+        // The ball + paddle definitely don't collide!
+        return SDL_FALSE;
+    }
+    
+    // Next, check for overlapping, opaque pixels, one row at a time.  Paddle
+    // masks get shifted over to line up with the ball's masks.
+    const uint32_t * ballMask = game->balls[ballIndex].GetMask();
+    if ( ! ballMask) {
+        // Inactive balls (such as one just removed by a powerup) don't collide
+        return SDL_FALSE;
+    }
+    // Only uncut rows are checked, so the paddle's own masks are those of its
+    // restored image.
+    const Paddle * paddle = &game->paddles[paddleIndex];
+    const uint16_t * paddleMask = PaddleTemplateMasks[paddleIndex];
+    const int shift = paddleRect.x - ballRect.x;
+    const int16_t end = (int16_t)(intersection.y + intersection.h - paddleRect.y);
+    int16_t uncutEnd;
+    for (int16_t py = paddle->FindUncutRows((int16_t)(intersection.y - paddleRect.y), &uncutEnd); py < end; py = paddle->FindUncutRows(uncutEnd, &uncutEnd)) {
+        for (const int16_t runEnd = SDL_min(uncutEnd, end); py < runEnd; ++py) {
+            const uint64_t paddleRow = paddleMask[py];
+            const uint64_t paddleRowAligned = (shift >= 0) ? (paddleRow << shift) : (paddleRow >> -shift);
+            if (ballMask[py + paddleRect.y - ballRect.y] & paddleRowAligned) {
+                return SDL_TRUE;
+            }
+        }
+    }
+    
+    // Nope, no collision
+    return SDL_FALSE;
+}
+
+// GameIsBallPowerupCollision -- determines if a powerup and a ball are colliding
+//   (powerups are solid squares), outputting their intersection, if so
+static SDL_bool GameIsBallPowerupCollision(const GameState * game, uint16_t ballIndex, uint16_t powerupIndex, SDL_Rect * ballPowerupIntersection)
+{
+    // First, check to see if the ball + powerup's rects match up
+    SDL_Rect ballRect, powerupRect, intersection;
+    game->balls[ballIndex].GetRect(&ballRect);
+    game->powerups[powerupIndex].GetRect(&powerupRect);
+    if ( ! SDL_IntersectRect(&ballRect, &powerupRect, &intersection)) {
+        // The ball + powerup definitely don't collide!
+        return SDL_FALSE;
+    }
+    
+    // Next, look for any non-transparent ball pixels, inside the intersection
+    const uint32_t * ballMask = game->balls[ballIndex].GetMask();
+    if ( ! ballMask) {
+        // Inactive balls (such as one just removed by a powerup) don't collide
+        return SDL_FALSE;
+    }
+    const uint32_t columns = (uint32_t)(((1ull << intersection.w) - 1) << (intersection.x - ballRect.x));
+    for (int y = intersection.y; y < (intersection.y + intersection.h); ++y) {
+        if (ballMask[y - ballRect.y] & columns) {
+            *ballPowerupIntersection = intersection;
+            return SDL_TRUE;
+        }
+    }
+    
+    // Nope, no collision
+    return SDL_FALSE;
+}
+
+// GameFindBallSweepHit -- finds when a ball, moving for one game-tick, first
+//   reaches the uncut rows of a paddle that it's heading towards, or an active
+//   powerup, if it does.  'outT' gets the fraction of the ball's velocity that
+//   it can move, to end up BallSweepPenetration pixels past the point of
+//   contact.  That may be a bit more than 1, for hits near the end of the
+//   ball's move.
+static SDL_bool GameFindBallSweepHit(const GameState * game, uint16_t ballIndex, Real * outT)
+{
+    const Ball * ball = &game->balls[ballIndex];
+    const Real r = BallRadius;
+    SDL_bool didHit = SDL_FALSE;
+    Real t, firstT = 1.f;
+    for (uint8_t i = 0; i < PaddleCount; ++i) {
+        // Balls only bounce off of a paddle that they're heading towards, and
+        // can pass through the gaps between its uncut rows
+        const Paddle * paddle = &game->paddles[i];
+        if ((ball->vx * Real(paddle->ballBounceDirection)) >= Real(0.f)) {
+            continue;
+        }
+        int16_t uncutEnd;
+        for (int16_t top = paddle->FindUncutRows(paddle->cutTop, &uncutEnd); top < paddle->cutBottom; top = paddle->FindUncutRows(uncutEnd, &uncutEnd)) {
+            const int16_t bottom = SDL_min(uncutEnd, paddle->cutBottom);
+            if (MathSweepCircleRect(ball->cx, ball->cy, ball->vx, ball->vy, r,
+                                    Real(paddle->Left()), paddle->Top() + Real(top),
+                                    Real(paddle->Right()), paddle->Top() + Real(bottom),
+                                    &t) &&
+                (t < firstT))
+            {
+                firstT = t;
+                didHit = SDL_TRUE;
+            }
+        }
+    }
+    for (uint16_t i = 0; i < game->powerupCapacity; ++i) {
+        const Powerup * powerup = &game->powerups[i];
+        if (powerup->type == PowerupType_Inactive) {
+            continue;
+        }
+        if (MathSweepCircleRect(ball->cx, ball->cy, ball->vx, ball->vy, r,
+                                (float)powerup->x, (float)powerup->y,
+                                (float)(powerup->x + PowerupSize), (float)(powerup->y + PowerupSize),
+                                &t) &&
+            (t < firstT))
+        {
+            firstT = t;
+            didHit = SDL_TRUE;
+        }
+    }
+    const Real speed = RealSqrt((ball->vx * ball->vx) + (ball->vy * ball->vy));
+    *outT = firstT + (BallSweepPenetration / speed);
+    return didHit;
+}
+
+// GameIsBallPaddleCollisionByPixels -- determines if a paddle and a ball are colliding,
+//   by checking one pixel at a time, in an image of the paddle from PaddleRender().
+//   Only used as a reference for the mask-based GameIsBallPaddleCollision(),
+//   when benchmarking it.
+static SDL_bool GameIsBallPaddleCollisionByPixels(const GameState * game, uint16_t ballIndex, uint8_t paddleIndex, SDL_Surface * paddleImage)
 {
     // First, check to see if the ball + paddle's rects match up
     SDL_Rect ballRect, paddleRect, intersection;
-    Balls[ballIndex].GetRect(&ballRect);
-    Paddles[paddleIndex].GetRect(&paddleRect);
+    game->balls[ballIndex].GetRect(&ballRect);
+    game->paddles[paddleIndex].GetRect(&paddleRect);
     if ( ! SDL_IntersectRect(&ballRect, &paddleRect, &intersection)) {
         // The ball + paddle definitely don't collide!
         return SDL_FALSE;
@@ -975,8 +2461,11 @@ static SDL_bool GameIsBallPaddleCollision(uint8_t ballIndex, uint8_t paddleIndex
     //return SDL_TRUE;
     
     // Next, do a pixel-alpha check, both in the ball and in the paddle
-    SDL_Surface * ballImage = Balls[ballIndex].GetImage();
-    SDL_Surface * paddleImage = Paddle::GetImage(paddleIndex);
+    SDL_Surface * ballImage = game->balls[ballIndex].GetImage();
+    if ( ! ballImage) {
+        // Inactive balls (such as one just removed by a powerup) don't collide
+        return SDL_FALSE;
+    }
     for (uint16_t y = intersection.y; y < (intersection.y + intersection.h); ++y) {
         for (uint16_t x = intersection.x; x < (intersection.x + intersection.w); ++x) {
             const uint16_t bx = x - ballRect.x;
@@ -1002,12 +2491,15 @@ static SDL_bool GameIsBallPaddleCollision(uint8_t ballIndex, uint8_t paddleIndex
     return SDL_FALSE;
 }
 
-static SDL_bool GameIsBallPowerupCollision(uint8_t ballIndex, uint8_t powerupIndex, SDL_Rect * ballPowerupIntersection)
+// GameIsBallPowerupCollisionByPixels -- determines if a powerup and a ball are
+//   colliding, by checking one pixel at a time.  Only used as a reference for
+//   the mask-based GameIsBallPowerupCollision(), when benchmarking it.
+static SDL_bool GameIsBallPowerupCollisionByPixels(const GameState * game, uint16_t ballIndex, uint16_t powerupIndex, SDL_Rect * ballPowerupIntersection)
 {
     // First, check to see if the ball + paddle's rects match up
     SDL_Rect ballRect, powerupRect, intersection;
-    Balls[ballIndex].GetRect(&ballRect);
-    Powerups[powerupIndex].GetRect(&powerupRect);
+    game->balls[ballIndex].GetRect(&ballRect);
+    game->powerups[powerupIndex].GetRect(&powerupRect);
     if ( ! SDL_IntersectRect(&ballRect, &powerupRect, &intersection)) {
         // The ball + powerup definitely don't collide!
         return SDL_FALSE;
@@ -1015,7 +2507,11 @@ static SDL_bool GameIsBallPowerupCollision(uint8_t ballIndex, uint8_t powerupInd
 
     //return SDL_TRUE;
     
-    SDL_Surface * ballImage = Balls[ballIndex].GetImage();
+    SDL_Surface * ballImage = game->balls[ballIndex].GetImage();
+    if ( ! ballImage) {
+        // Inactive balls (such as one just removed by a powerup) don't collide
+        return SDL_FALSE;
+    }
     for (uint16_t y = intersection.y; y < (intersection.y + intersection.h); ++y) {
         for (uint16_t x = intersection.x; x < (intersection.x + intersection.w); ++x) {
             const uint16_t bx = x - ballRect.x;
@@ -1045,82 +2541,424 @@ static SDL_bool GameIsBallPowerupCollision(uint8_t ballIndex, uint8_t powerupInd
 //                                              #                                 
 #pragma mark - Game Update
 
-// GameUpdate -- updates game-state; called 100 times per second
-static void GameUpdate()
+// GameUpdateBall -- moves + collides one ball, for GameUpdate(),
+//   applying any effects that its collisions have on the rest of the match.
+//   Healed paddles get their bits set in 'healedPaddles'.
+//
+//   Speculative updates leave everything but the ball alone, so that balls can
+//   be updated in parallel.  They give up, returning SDL_FALSE, at the first
+//   collision that would have done more than bounce the ball, leaving the ball
+//   part-way updated.
+static SDL_bool GameUpdateBall(GameState * game, uint16_t i, SDL_bool speculative, uint8_t * healedPaddles)
 {
-    // Get pressed-state for all keyboard keys
-    const Uint8 * keyState = SDL_GetKeyboardState(NULL);
+    if (game->balls[i].type == BallTypeInactive) {
+        return SDL_TRUE;
+    }
     
+    // Move the ball, bouncing off of walls.  Fast balls stop at the first
+    // thing in their way, so that they can't skip through it; the collision
+    // tests below then bounce them off of it.
+    Real sweepT;
+    if (game->balls[i].IsFast() && GameFindBallSweepHit(game, i, &sweepT)) {
+        game->balls[i].MovePart(sweepT);
+    } else {
+        game->balls[i].Move();
+    }
+    
+    // Ball/paddle collisions
+    for (uint8_t j = 0; j < SDL_arraysize(game->paddles); ++j) {
+        // For now, do collisions with the entire paddle, and not a cut-up
+        // one.  Eventually, paddles will be slice-able, probably with bits
+        // representing valid slices.
+        if (GameIsBallPaddleCollision(game, i, j)) {
+            // Make sure that successive collisions with the same ball +
+            // paddle, do not result in multiple bounces!
+            //
+            // I.e. only bounce the ball once per collision.
+            if ((game->balls[i].vx * game->paddles[j].ballBounceDirection) < 0) {
+                // Bounce the ball!
+                game->balls[i].vx *= -1.f;
+                game->balls[i].vy += (game->paddles[j].vy * PaddleToBallFriction);
+//                    SDL_Log("speed, paddle: %f", game->balls[i].Speed());
+//                    SDL_Log("vy, paddle: %f", game->balls[i].vy);
+                game->balls[i].type = game->paddles[j].ballType;
+            }
+        }
+    }
+    
+    // Ball/powerup collisions.  Only powerups listed in the ball's grid-cell
+    // can touch it, and they're listed in the same order as a full search.
+    SDL_Rect ballRect;
+    game->balls[i].GetRect(&ballRect);
+    const PowerupID * nearbyPowerups = NULL;
+    uint32_t numNearbyPowerups = game->powerupCapacity;
+    if (game->usePowerupGrid) {
+        numNearbyPowerups = game->powerupGrid.Find(ballRect.x, ballRect.y, &nearbyPowerups);
+    }
+    SDL_Rect ballPowerupIntersect;
+    for (uint32_t k = 0; k < numNearbyPowerups; ++k) {
+        const uint16_t j = nearbyPowerups ? nearbyPowerups[k] : k;
+        if (game->powerups[j].type != PowerupType_Inactive) {
+//                SDL_Rect ballRect;
+//                game->balls[i].GetRect(&ballRect);
+            SDL_Rect powerupRect;
+            game->powerups[j].GetRect(&powerupRect);
+            if (GameIsBallPowerupCollision(game, i, j, &ballPowerupIntersect)) {
+//                    SDL_Log("BALL/POWERUP INTERSECT: tick:%d, b:{%d,%d,%d,%d}, p:{%d,%d,%d,%d}, i:{%d,%d,%d,%d}, b.v:{%f,%f}\n",
+//                            DebugGameTickCount,
+//                            ballRect.x, ballRect.y, ballRect.w, ballRect.h,
+//                            powerupRect.x, powerupRect.y, powerupRect.w, powerupRect.h,
+//                            ballPowerupIntersect.x, ballPowerupIntersect.y, ballPowerupIntersect.w, ballPowerupIntersect.h,
+//                            game->balls[i].vx, game->balls[i].vy);
+//                    SDL_Log("BALL/POWERUP INTERSECT: tick:%d, i:{%d,%d,%d,%d}, b.v:{%f,%f}\n",
+//                            DebugGameTickCount,
+//                            ballPowerupIntersect.x, ballPowerupIntersect.y, ballPowerupIntersect.w, ballPowerupIntersect.h,
+//                            game->balls[i].vx, game->balls[i].vy);
+
+                //
+                // There -is- a collision between a ball and a powerup.  Now,
+                // see if there should be a response, by:
+                //   - 1st, seeing if the ball should bounce along a particular axis.
+                //     This is accomplished by looking at the sizes of the collision's intersection-rect.
+                //   - 2nd, preventing a collision-response from occurring multiple
+                //     times, for a single collision.  This is accomplished by looking
+                //     at which direction the ball is heading in, and where the collision's
+                //     intersection-rect sits inside the powerup's rect.
+                //
+                bool didCollide = false;
+                if (ballPowerupIntersect.w >= ballPowerupIntersect.h) {
+                    if ((game->balls[i].vy > 0 && ballPowerupIntersect.y == powerupRect.y) ||
+                        (game->balls[i].vy < 0 && (ballPowerupIntersect.y + ballPowerupIntersect.h) == (powerupRect.y + powerupRect.h)))
+                    {
+                        game->balls[i].vy *= -1.f;
+                        didCollide = true;
+                    }
+                }
+                if (ballPowerupIntersect.w <= ballPowerupIntersect.h) {
+                    if ((game->balls[i].vx > 0 && ballPowerupIntersect.x == powerupRect.x) ||
+                        (game->balls[i].vx < 0 && (ballPowerupIntersect.x + ballPowerupIntersect.w) == (powerupRect.x + powerupRect.w)))
+                    {
+                        game->balls[i].vx *= -1.f;
+                        didCollide = true;
+                    }
+                }
+                
+                // Apply powerups, as warranted
+                if (didCollide && speculative) {
+                    return SDL_FALSE;
+                }
+                if (didCollide) {
+                    ++game->powerupHits[game->powerups[j].type];
+                    switch (game->powerups[j].type) {
+                        case PowerupType_Plain:
+                        case PowerupType_Reserved1:
+                        case PowerupType_Reserved2:
+                        case PowerupType_Reserved3:
+                        case PowerupType_Reserved4:
+                        case PowerupType_Reserved5:
+                        case PowerupType_Reserved6:
+                        {
+                            // Do nothing for 'Plain' powerups.
+                        } break;
+                            
+                        case PowerupType_Health: {
+                            // Apply health, but only if the ball is marked with a paddle color.
+                            int8_t healPaddle = PaddleIDForBallType(game->paddles, game->balls[i].type);
+                            if (healPaddle >= 0) {
+                                PaddleHeal(&game->paddles[healPaddle], healPaddle);
+                                *healedPaddles |= (1 << healPaddle);
+                            }
+                        } break;
+                            
+                        case PowerupType_AddBall: {
+                            // Look for an unused slot in game->balls[].  If one is found,
+                            // respawn that ball.
+                            const uint16_t newBallID = GameBallFindFree(game);
+                            if (newBallID < game->ballCapacity) {
+                                GameBallSpawn(game, newBallID);
+                            }
+                        } break;
+                        
+                        case PowerupType_RemoveBall: {
+                            // Remove the ball, but only if the number of
+                            // active balls is greater than one.  (I.e. leave
+                            // at least one ball on-screen.)
+                            if (game->activeBallCount > 1) {
+                                GameBallRemove(game, i);
+                            }
+                        } break;
+                    }
+                }
+            }
+        }
+    }
+
+    // Ball/score-zone collisions
+    for (uint8_t j = 0; j < SDL_arraysize(ScoreZones); ++j) {
+        if (SDL_HasIntersection(&ballRect, &ScoreZones[j])) {
+            if (speculative) {
+                return SDL_FALSE;
+            }
+            // For now, just add score, then reset after a short interval
+            game->scores[(j % 2) == 0]++;
+            GameBallRemove(game, i);
+            game->ticksToNextRound = TimingSecondsToTicks(GameTimeToNextRoundDefault);
+        }
+    }
+    return SDL_TRUE;
+}
+
+// GameBallPool -- worker threads, for updating a match's balls in parallel.
+//   Matches with a pool, and at least GameBallPoolMinBalls balls, update their
+//   balls in two phases:
+//    1. Each thread speculatively updates its share of the balls, as per
+//       GameUpdateBall().  Nothing but the balls themselves changes, so
+//       threads don't need to coordinate.
+//    2. Then, on one thread, in ball order, balls that gave up get updated
+//       again, for real, from where they started.  So do balls that earlier
+//       ones spawned, and balls that went near a paddle that an earlier ball
+//       healed (which could change what they hit).
+//   Each ball then ends up as if all had been updated in order, on one thread,
+//   so results are identical to those of the serial update.
+static const uint16_t GameBallPoolMinBalls = 256;   // matches with fewer balls get updated serially, as the hand-off would cost more than it saves
+static const uint8_t GameBallPoolMaxThreads = 64;
+static const uint8_t GameBallNearPaddleMargin = 2;  // pixels, around a ball's path, that count as being near a paddle
+enum : uint8_t {
+    GAME_BALL_GAVE_UP   = (1 << 7)      // set per ball that gave up in phase 1, along with (1 << paddleIndex), per paddle that it went near
+};
+struct GameBallPool;
+struct GameBallPoolWorker {
+    GameBallPool * pool;
+    uint8_t index;
+    SDL_Thread * thread;
+    SDL_sem * startWork;            // posted to start the worker on phase 1 (or to make it quit)
+};
+struct GameBallPool {
+    uint8_t numThreads;             // including the thread that calls GameBallPoolUpdate()
+    GameBallPoolWorker workers[GameBallPoolMaxThreads];     // [0] is the calling thread
+    SDL_sem * workDone;             // posted by each worker, as it finishes phase 1
+    SDL_bool quit;
+    uint16_t ballCapacity;          // most balls that a match can have, to use the pool
+    Ball * ballsBefore;             // each ball, as it was before phase 1
+    uint8_t * ballFlags;            // each ball's GAME_BALL_* flags, from phase 1
+    GameState * game;               // match being updated
+};
+
+// GameBallPoolSpeculate -- phase 1 of a GameBallPool update, for one thread's share of the balls
+static void GameBallPoolSpeculate(GameBallPool * pool, uint8_t worker)
+{
+    GameState * game = pool->game;
+    const uint16_t first = (uint16_t)(((uint32_t)game->ballCapacity * worker) / pool->numThreads);
+    const uint16_t last = (uint16_t)(((uint32_t)game->ballCapacity * (worker + 1)) / pool->numThreads);
+    const Real margin = BallRadius + Real(GameBallNearPaddleMargin);
+    for (uint16_t i = first; i < last; ++i) {
+        const Ball * before = &pool->ballsBefore[i];
+        const Ball * after = &game->balls[i];
+        pool->ballsBefore[i] = game->balls[i];
+        uint8_t healedPaddles = 0;
+        pool->ballFlags[i] = GameUpdateBall(game, i, SDL_TRUE, &healedPaddles) ? 0 : GAME_BALL_GAVE_UP;
+        if (before->type == BallTypeInactive) {
+            continue;
+        }
+        
+        // Note the paddles that the ball's path, from where it started,
+        // towards where its velocity would have taken it, to where it ended
+        // up, went near
+        const Real left = SDL_min(SDL_min(before->cx, before->cx + before->vx), after->cx) - margin;
+        const Real right = SDL_max(SDL_max(before->cx, before->cx + before->vx), after->cx) + margin;
+        const Real top = SDL_min(SDL_min(before->cy, before->cy + before->vy), after->cy) - margin;
+        const Real bottom = SDL_max(SDL_max(before->cy, before->cy + before->vy), after->cy) + margin;
+        for (uint8_t j = 0; j < PaddleCount; ++j) {
+            const Paddle * paddle = &game->paddles[j];
+            if (right > Real(paddle->Left()) && left < Real(paddle->Right()) &&
+                bottom > paddle->Top() && top < paddle->Bottom())
+            {
+                pool->ballFlags[i] |= (1 << j);
+            }
+        }
+    }
+}
+
+// GameBallPoolWorkerRun -- runs phase 1 of GameBallPool updates, as asked to, until the pool quits
+static int GameBallPoolWorkerRun(void * data)
+{
+    GameBallPoolWorker * worker = (GameBallPoolWorker *) data;
+    while (1) {
+        SDL_SemWait(worker->startWork);
+        if (worker->pool->quit) {
+            return 0;
+        }
+        GameBallPoolSpeculate(worker->pool, worker->index);
+        SDL_SemPost(worker->pool->workDone);
+    }
+}
+
+// GameBallPoolDestroy -- stops a pool's threads, then frees its resources
+static void GameBallPoolDestroy(GameBallPool * pool)
+{
+    pool->quit = SDL_TRUE;
+    for (uint8_t i = 1; i < pool->numThreads; ++i) {
+        if (pool->workers[i].thread) {
+            SDL_SemPost(pool->workers[i].startWork);
+            SDL_WaitThread(pool->workers[i].thread, NULL);
+        }
+        if (pool->workers[i].startWork) {
+            SDL_DestroySemaphore(pool->workers[i].startWork);
+        }
+    }
+    if (pool->workDone) {
+        SDL_DestroySemaphore(pool->workDone);
+    }
+    SDL_free(pool->ballsBefore);
+    SDL_free(pool->ballFlags);
+    SDL_memset(pool, 0, sizeof(GameBallPool));
+}
+
+// GameBallPoolCreate -- starts (numThreads - 1) threads, to update the balls
+//   of matches with up to 'ballCapacity' balls, along with the calling thread
+static SDL_bool GameBallPoolCreate(GameBallPool * pool, uint8_t numThreads, uint16_t ballCapacity)
+{
+    SDL_memset(pool, 0, sizeof(GameBallPool));
+    pool->numThreads = SDL_max(1, SDL_min(numThreads, GameBallPoolMaxThreads));
+    pool->ballCapacity = ballCapacity;
+    pool->ballsBefore = (Ball *) SDL_calloc(ballCapacity, sizeof(Ball));
+    pool->ballFlags = (uint8_t *) SDL_calloc(ballCapacity, sizeof(uint8_t));
+    pool->workDone = SDL_CreateSemaphore(0);
+    if ( ! pool->ballsBefore || ! pool->ballFlags || ! pool->workDone) {
+        SDL_Log("%s, out of memory", __FUNCTION__);
+        GameBallPoolDestroy(pool);
+        return SDL_FALSE;
+    }
+    for (uint8_t i = 0; i < pool->numThreads; ++i) {
+        GameBallPoolWorker * worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->index = i;
+        if (i == 0) {
+            continue;
+        }
+        worker->startWork = SDL_CreateSemaphore(0);
+        worker->thread = worker->startWork ? SDL_CreateThread(GameBallPoolWorkerRun, "GameBallPoolWorker", worker) : NULL;
+        if ( ! worker->thread) {
+            SDL_Log("%s, couldn't start thread: %s", __FUNCTION__, SDL_GetError());
+            GameBallPoolDestroy(pool);
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+// GameBallPoolUpdate -- moves + collides all of a match's balls, with the
+//   pool's threads, exactly as GameUpdate() would on its own
+static void GameBallPoolUpdate(GameBallPool * pool, GameState * game)
+{
+    uint8_t healedPaddles = 0;
+    if (game->ballCapacity > pool->ballCapacity) {
+        for (uint16_t i = 0; i < game->ballCapacity; ++i) {
+            GameUpdateBall(game, i, SDL_FALSE, &healedPaddles);
+        }
+        return;
+    }
+    
+    // Phase 1: speculate, in parallel
+    pool->game = game;
+    for (uint8_t i = 1; i < pool->numThreads; ++i) {
+        SDL_SemPost(pool->workers[i].startWork);
+    }
+    GameBallPoolSpeculate(pool, 0);
+    for (uint8_t i = 1; i < pool->numThreads; ++i) {
+        SDL_SemWait(pool->workDone);
+    }
+    
+    // Phase 2: redo, in order, whatever speculating couldn't, or got wrong
+    for (uint16_t i = 0; i < game->ballCapacity; ++i) {
+        if (pool->ballsBefore[i].type == BallTypeInactive) {
+            if (game->balls[i].type != BallTypeInactive) {
+                GameUpdateBall(game, i, SDL_FALSE, &healedPaddles);     // spawned by an earlier ball
+            }
+        } else if (pool->ballFlags[i] & (GAME_BALL_GAVE_UP | healedPaddles)) {
+            game->balls[i] = pool->ballsBefore[i];
+            GameUpdateBall(game, i, SDL_FALSE, &healedPaddles);
+        }
+    }
+}
+
+// GameUpdate -- updates a match's game-state; called TicksPerSecond times per second
+//   All paddle input for the tick comes from 'input'.
+static void GameUpdate(GameState * game, GameInput input)
+{
     // Re-init?
-    if (GameTicksToNextRound > 0) {
-        --GameTicksToNextRound;
-        if (GameTicksToNextRound == 0) {
-            GameInit(GAME_INIT_NEXT_ROUND);
+    if (game->ticksToNextRound > 0) {
+        --game->ticksToNextRound;
+        if (game->ticksToNextRound == 0) {
+            GameInit(game, GAME_INIT_NEXT_ROUND);
         }
     }
     
     // Laser-magnitude updates
-    for (uint8_t i = 0; i < SDL_arraysize(Lasers); ++i) {
-        if (Lasers[i].magnitude == 0.f) {
+    for (uint8_t i = 0; i < SDL_arraysize(game->lasers); ++i) {
+        if (game->lasers[i].magnitude == 0.f) {
             continue;
         }
-        Lasers[i].magnitude += LaserMagnitudeStep;
-        if (Lasers[i].magnitude < 0.f) {
-            Lasers[i].magnitude = 0.f;
+        game->lasers[i].magnitude += TimingPerTick(LaserMagnitudeStep);
+        if (game->lasers[i].magnitude < 0.f) {
+            game->lasers[i].magnitude = 0.f;
         }
     }
 
     // Paddle updates
-    for (uint8_t i = 0; i < SDL_arraysize(Paddles); ++i) {
+    for (uint8_t i = 0; i < SDL_arraysize(game->paddles); ++i) {
+        const uint8_t paddleInput = input.Get(i);
+        
         // Adjust paddle velocity
-        if (keyState[Paddles[i].keyDown]) {
+        const Real vStep = TimingPerTickPerTick(PaddleVStep);
+        if (paddleInput & GAME_INPUT_DOWN) {
             // Going down
-            Paddles[i].vy += PaddleVStep;
-        } else if (keyState[Paddles[i].keyUp]) {
+            game->paddles[i].vy += vStep;
+        } else if (paddleInput & GAME_INPUT_UP) {
             // Going up
-            Paddles[i].vy -= PaddleVStep;
-        } else if (Paddles[i].vy < 0.f) {
+            game->paddles[i].vy -= vStep;
+        } else if (game->paddles[i].vy < 0.f) {
             // Slow a downward-moving paddle
-            Paddles[i].vy += PaddleVStep;
-            if (Paddles[i].vy > 0.f) {
+            game->paddles[i].vy += vStep;
+            if (game->paddles[i].vy > 0.f) {
                 // Make sure it doesn't start going in the other direction!
-                Paddles[i].vy = 0.f;
+                game->paddles[i].vy = 0.f;
             }
-        } else if (Paddles[i].vy > 0.f) {
+        } else if (game->paddles[i].vy > 0.f) {
             // Slow an upward-moving paddle
-            Paddles[i].vy -= PaddleVStep;
-            if (Paddles[i].vy < 0.f) {
+            game->paddles[i].vy -= vStep;
+            if (game->paddles[i].vy < 0.f) {
                 // Make sure it doesn't start going in the other direction!
-                Paddles[i].vy = 0.f;
+                game->paddles[i].vy = 0.f;
             }
         }
         
         // Move the paddle, stopping at walls
-        Paddles[i].y += Paddles[i].vy;
-        if ((Paddles[i].y + (float)(Paddles[i].cutTop + 1)) <= 0.f) {
+        game->paddles[i].y += game->paddles[i].vy;
+        if ((game->paddles[i].y + (float)(game->paddles[i].cutTop + 1)) <= 0.f) {
             // Stop at the top wall
-            Paddles[i].y = (float)-(Paddles[i].cutTop + 1);
-            Paddles[i].vy = 0.f;
-        } else if ((Paddles[i].y + (float)(Paddles[i].cutBottom)) >= (float)(ScreenHeight - HUDHeight)) {
+            game->paddles[i].y = (float)-(game->paddles[i].cutTop + 1);
+            game->paddles[i].vy = 0.f;
+        } else if ((game->paddles[i].y + (float)(game->paddles[i].cutBottom)) >= (float)(ScreenHeight - HUDHeight)) {
             // Stop at the bottom wall
-            Paddles[i].y = (float)(ScreenHeight - HUDHeight) - (float)(Paddles[i].cutBottom);
-            Paddles[i].vy = 0.f;
+            game->paddles[i].y = (float)(ScreenHeight - HUDHeight) - (float)(game->paddles[i].cutBottom);
+            game->paddles[i].vy = 0.f;
         }
         
         // Recharge lasers
-        if (Paddles[i].laserRechargeTicks > 0) {
-            Paddles[i].laserRechargeTicks--;
+        if (game->paddles[i].laserRechargeTicks > 0) {
+            game->paddles[i].laserRechargeTicks--;
         }
         
         // Fire lasers
-        if (Lasers[i].magnitude == 0.f) {                           // is a laser not on-screen?
-            if (Paddles[i].laserRechargeTicks == 0) {               // is the laser charged?
-                if (Paddles[i].cutTop < Paddles[i].cutBottom) {     // is at least some of the paddle still alive?
-                    if (keyState[Paddles[i].keyLaser]) {            // is the paddle-firing key pressed?
-                        Lasers[i].magnitude = LaserInitialMagnitude;
-                        Lasers[i].cy = ((float)(Paddles[i].cutBottom - Paddles[i].cutTop) / 2.f) + (float)Paddles[i].cutTop + Paddles[i].Top();
-                        Lasers[i].gameTicksUntilCut = 0;
-                        Paddles[i].laserRechargeTicks = PaddleDefaultLaserRechargeTicks;
+        if (game->lasers[i].magnitude == 0.f) {                           // is a laser not on-screen?
+            if (game->paddles[i].laserRechargeTicks == 0) {               // is the laser charged?
+                if (game->paddles[i].cutTop < game->paddles[i].cutBottom) {     // is at least some of the paddle still alive?
+                    if (paddleInput & GAME_INPUT_LASER) {           // is the paddle-firing key pressed?
+                        game->lasers[i].magnitude = LaserInitialMagnitude;
+                        game->lasers[i].cy = (Real(game->paddles[i].cutBottom - game->paddles[i].cutTop) / Real(2.f)) + Real(game->paddles[i].cutTop) + game->paddles[i].Top();
+                        game->lasers[i].gameTicksUntilCut = 0;
+                        game->paddles[i].laserRechargeTicks = TimingSecondsToTicks(PaddleDefaultLaserRechargeTime);
                     }
                 }
             }
@@ -1128,357 +2966,673 @@ static void GameUpdate()
     }
     
     // Laser-cuts
-    for (uint8_t i = 0; i < SDL_arraysize(Lasers); ++i) {
-        if (Lasers[i].gameTicksUntilCut > 0) {
-            Lasers[i].gameTicksUntilCut--;
+    for (uint8_t i = 0; i < SDL_arraysize(game->lasers); ++i) {
+        if (game->lasers[i].gameTicksUntilCut > 0) {
+            game->lasers[i].gameTicksUntilCut--;
         }
-        if (Lasers[i].gameTicksUntilCut == 0) {
+        if (game->lasers[i].gameTicksUntilCut == 0) {
             SDL_Rect laserRect;
-            if (Lasers[i].GetRect(&laserRect, i) == 0) {
-                for (uint8_t j = 0; j < SDL_arraysize(Paddles); ++j) {
+            if (game->lasers[i].GetRect(&laserRect, i, game->paddles) == 0) {
+                for (uint8_t j = 0; j < SDL_arraysize(game->paddles); ++j) {
                     if (i != j) {
                         SDL_Rect paddleRect, intersection;
-                        Paddles[j].GetRect(&paddleRect);
+                        game->paddles[j].GetRect(&paddleRect);
                         if (SDL_IntersectRect(&laserRect, &paddleRect, &intersection)) {
-                            intersection.x -= paddleRect.x;
                             intersection.y -= paddleRect.y;
-                            SDL_Surface * paddleImage = Paddle::GetImage(j);
-                            if (paddleImage) {
-#if DEBUG_PADDLE_DRAWING
-                                SDL_FillRect(paddleImage, &intersection, SDL_MapRGBA(paddleImage->format, 0x00, 0x00, 0x00, 0x34));
-#else
-                                SDL_FillRect(paddleImage, &intersection, SDL_MapRGBA(paddleImage->format, 0x00, 0x00, 0x00, 0x00));
-#endif
-                            
-                                if ((intersection.y <= Paddles[j].cutTop) && ((intersection.y + intersection.h) >= Paddles[j].cutTop)) {
-                                    Paddles[j].cutTop = Paddle::CalcEdge(paddleImage, intersection.y + intersection.h, PaddleMaxH - 1, 1);
-                                }
-                                if ((intersection.y <= Paddles[j].cutBottom) && ((intersection.y + intersection.h) >= Paddles[j].cutBottom)) {
-                                    // TODO: explain, in comments, why '1' is added to CalcEdge result.  Yes, this is needed, maybe.
-                                    Paddles[j].cutBottom = 1 + Paddle::CalcEdge(paddleImage, intersection.y, 0, -1);
-                                }
-                            }
+                            PaddleCut(&game->paddles[j], j, intersection.y, intersection.y + intersection.h);
                         }
                     }
                 }
             }
             
-            Lasers[i].gameTicksUntilCut = LaserCutInterval;
+            game->lasers[i].gameTicksUntilCut = TimingSecondsToTicks(LaserCutInterval);
         }
     }
     
     // Powerup updates
-    for (uint8_t i = 0; i < SDL_arraysize(Powerups); ++i) {
-        --Powerups[i].gameTicksLeft;
-        if (Powerups[i].gameTicksLeft <= 0) {
-            if (Powerups[i].type == PowerupType_Inactive) {
-                PowerupRespawn(i);
+    GamePowerupSpotsRefresh(game);
+    for (uint16_t i = 0; i < game->powerupCapacity; ++i) {
+        --game->powerups[i].gameTicksLeft;
+        if (game->powerups[i].gameTicksLeft <= 0) {
+            if (game->powerups[i].type == PowerupType_Inactive) {
+                PowerupRespawn(game->powerups, game->powerupCapacity, i, &game->powerupSpots, &game->rand);
             } else {
-                PowerupDeactivate(i);
+                PowerupDeactivate(game->powerups, game->powerupCapacity, i, &game->powerupSpots, &game->rand);
             }
+            game->powerupGridIsStale = SDL_TRUE;
         }
     }
+    if (game->usePowerupGrid && game->powerupGridIsStale) {
+        PowerupGridBuild(&game->powerupGrid, game->powerups, game->powerupCapacity);
+        game->powerupGridIsStale = SDL_FALSE;
+    }
     
     // Ball updates
-    for (uint8_t i = 0; i < SDL_arraysize(Balls); ++i) {
-        if (Balls[i].type == BallTypeInactive) {
-            continue;
+    if (game->ballPool && game->ballCapacity >= GameBallPoolMinBalls) {
+        GameBallPoolUpdate(game->ballPool, game);
+    } else {
+        uint8_t healedPaddles = 0;
+        for (uint16_t i = 0; i < game->ballCapacity; ++i) {
+            GameUpdateBall(game, i, SDL_FALSE, &healedPaddles);
         }
-        
-        // Move the ball
-        Balls[i].cx += Balls[i].vx;
-        Balls[i].cy += Balls[i].vy;
+    }
+}
 
-        // Ball/wall collisions
-        if ((Balls[i].Bottom()) > (float)(ScreenHeight - HUDHeight)) {
-            // Collision, bottom-wall
-            Balls[i].cy = ((float)(ScreenHeight - HUDHeight)) - BallRadius;
-            Balls[i].vy *= -1.f;
-            Balls[i].ChopVY();
-        } else if ((Balls[i].Top()) < 0.f) {
-            // Collision, top-wall
-            Balls[i].cy = BallRadius;
-            Balls[i].vy *= -1.f;
-            Balls[i].ChopVY();
-        } else if ((Balls[i].Right()) > (float)ScreenWidth) {
-            // Collision, right-wall
-            Balls[i].cx = ((float)ScreenWidth) - BallRadius;
-            Balls[i].vx *= -1.f;
-        } else if ((Balls[i].Left()) < 0.f) {
-            // Collision, left-wall
-            Balls[i].cx = BallRadius;
-            Balls[i].vx *= -1.f;
-        }
-        
-        // Ball/paddle collisions
-        for (uint8_t j = 0; j < SDL_arraysize(Paddles); ++j) {
-            // For now, do collisions with the entire paddle, and not a cut-up
-            // one.  Eventually, paddles will be slice-able, probably with bits
-            // representing valid slices.
-            if (GameIsBallPaddleCollision(i, j)) {
-                // Make sure that successive collisions with the same ball +
-                // paddle, do not result in multiple bounces!
-                //
-                // I.e. only bounce the ball once per collision.
-                if ((Balls[i].vx * Paddles[j].ballBounceDirection) < 0) {
-                    // Bounce the ball!
-                    Balls[i].vx *= -1.f;
-                    Balls[i].vy += (Paddles[j].vy * PaddleToBallFriction);
-//                    SDL_Log("speed, paddle: %f", Balls[i].Speed());
-//                    SDL_Log("vy, paddle: %f", Balls[i].vy);
-                    Balls[i].type = Paddles[j].ballType;
-                }
-            }
-        }
-        
-        // Ball/powerup collisions
-        SDL_Rect ballPowerupIntersect;
-        for (uint8_t j = 0; j < SDL_arraysize(Powerups); ++j) {
-            if (Powerups[j].type != PowerupType_Inactive) {
-//                SDL_Rect ballRect;
-//                Balls[i].GetRect(&ballRect);
-                SDL_Rect powerupRect;
-                Powerups[j].GetRect(&powerupRect);
-                if (GameIsBallPowerupCollision(i, j, &ballPowerupIntersect)) {
-//                    SDL_Log("BALL/POWERUP INTERSECT: tick:%d, b:{%d,%d,%d,%d}, p:{%d,%d,%d,%d}, i:{%d,%d,%d,%d}, b.v:{%f,%f}\n",
-//                            DebugGameTickCount,
-//                            ballRect.x, ballRect.y, ballRect.w, ballRect.h,
-//                            powerupRect.x, powerupRect.y, powerupRect.w, powerupRect.h,
-//                            ballPowerupIntersect.x, ballPowerupIntersect.y, ballPowerupIntersect.w, ballPowerupIntersect.h,
-//                            Balls[i].vx, Balls[i].vy);
-//                    SDL_Log("BALL/POWERUP INTERSECT: tick:%d, i:{%d,%d,%d,%d}, b.v:{%f,%f}\n",
-//                            DebugGameTickCount,
-//                            ballPowerupIntersect.x, ballPowerupIntersect.y, ballPowerupIntersect.w, ballPowerupIntersect.h,
-//                            Balls[i].vx, Balls[i].vy);
-
-                    //
-                    // There -is- a collision between a ball and a powerup.  Now,
-                    // see if there should be a response, by:
-                    //   - 1st, seeing if the ball should bounce along a particular axis.
-                    //     This is accomplished by looking at the sizes of the collision's intersection-rect.
-                    //   - 2nd, preventing a collision-response from occurring multiple
-                    //     times, for a single collision.  This is accomplished by looking
-                    //     at which direction the ball is heading in, and where the collision's
-                    //     intersection-rect sits inside the powerup's rect.
-                    //
-                    bool didCollide = false;
-                    if (ballPowerupIntersect.w >= ballPowerupIntersect.h) {
-                        if ((Balls[i].vy > 0 && ballPowerupIntersect.y == powerupRect.y) ||
-                            (Balls[i].vy < 0 && (ballPowerupIntersect.y + ballPowerupIntersect.h) == (powerupRect.y + powerupRect.h)))
-                        {
-                            Balls[i].vy *= -1.f;
-                            didCollide = true;
-                        }
-                    }
-                    if (ballPowerupIntersect.w <= ballPowerupIntersect.h) {
-                        if ((Balls[i].vx > 0 && ballPowerupIntersect.x == powerupRect.x) ||
-                            (Balls[i].vx < 0 && (ballPowerupIntersect.x + ballPowerupIntersect.w) == (powerupRect.x + powerupRect.w)))
-                        {
-                            Balls[i].vx *= -1.f;
-                            didCollide = true;
-                        }
-                    }
-                    
-                    // Apply powerups, as warranted
-                    if (didCollide) {
-                        switch (Powerups[j].type) {
-                            case PowerupType_Plain:
-                            case PowerupType_Reserved1:
-                            case PowerupType_Reserved2:
-                            case PowerupType_Reserved3:
-                            case PowerupType_Reserved4:
-                            case PowerupType_Reserved5:
-                            case PowerupType_Reserved6:
-                            {
-                                // Do nothing for 'Plain' powerups.
-                            } break;
-                                
-                            case PowerupType_Health: {
-                                // Apply health, but only if the ball is marked with a paddle color.
-                                int8_t healPaddle = PaddleIDForBallType(Balls[i].type);
-                                if (healPaddle >= 0) {
-                                    PaddleHeal(healPaddle);
-                                }
-                            } break;
-                                
-                            case PowerupType_AddBall: {
-                                // Look for an unused slot in Balls[].  If one is found,
-                                // respawn that ball.
-                                uint8_t newBallID;
-                                for (newBallID = 0; newBallID < SDL_arraysize(Balls); ++newBallID) {
-                                    if (Balls[newBallID].type == BallTypeInactive) {
-                                        break;
-                                    }
-                                }
-                                if (newBallID < SDL_arraysize(Balls)) {
-                                    BallRespawn(newBallID);
-                                }
-                            } break;
-                            
-                            case PowerupType_RemoveBall: {
-                                // Remove the ball, but only if the number of
-                                // active balls is greater than one.  (I.e. leave
-                                // at least one ball on-screen.)
-                                uint8_t count = 0;
-                                for (uint8_t k = 0; k < SDL_arraysize(Balls); ++k) {
-                                    if (Balls[k].type != BallTypeInactive) {
-                                        if (++count > 1) {
-                                            Balls[i].type = BallTypeInactive;
-                                            break;
-                                        }
-                                    }
-                                }
-                            } break;
-                        }
-                    }
-                }
-            }
+// GameStatesMatch -- compares all simulated state of two matches, bit-for-bit
+static SDL_bool GameStatesMatch(const GameState * a, const GameState * b)
+{
+    #define GAME_STATES_MATCH_FIELD(FIELD) \
+        if (SDL_memcmp(&a->FIELD, &b->FIELD, sizeof(a->FIELD)) != 0) { return SDL_FALSE; }
+    GAME_STATES_MATCH_FIELD(ballCapacity);
+    GAME_STATES_MATCH_FIELD(activeBallCount);
+    GAME_STATES_MATCH_FIELD(powerupCapacity);
+    for (uint16_t i = 0; i < a->ballCapacity; ++i) {
+        GAME_STATES_MATCH_FIELD(balls[i].cx);
+        GAME_STATES_MATCH_FIELD(balls[i].cy);
+        GAME_STATES_MATCH_FIELD(balls[i].vx);
+        GAME_STATES_MATCH_FIELD(balls[i].vy);
+        GAME_STATES_MATCH_FIELD(balls[i].type);
+    }
+    for (uint8_t i = 0; i < PaddleCount; ++i) {
+        GAME_STATES_MATCH_FIELD(paddles[i].y);
+        GAME_STATES_MATCH_FIELD(paddles[i].vy);
+        GAME_STATES_MATCH_FIELD(paddles[i].cutTop);
+        GAME_STATES_MATCH_FIELD(paddles[i].cutBottom);
+        GAME_STATES_MATCH_FIELD(paddles[i].laserRechargeTicks);
+        GAME_STATES_MATCH_FIELD(lasers[i].cy);
+        GAME_STATES_MATCH_FIELD(lasers[i].magnitude);
+        GAME_STATES_MATCH_FIELD(lasers[i].gameTicksUntilCut);
+        GAME_STATES_MATCH_FIELD(scores[i]);
+        GAME_STATES_MATCH_FIELD(paddles[i].numCuts);
+        if (SDL_memcmp(a->paddles[i].cuts, b->paddles[i].cuts, sizeof(a->paddles[i].cuts)) != 0) {
+            return SDL_FALSE;
         }
+    }
+    for (uint16_t i = 0; i < a->powerupCapacity; ++i) {
+        GAME_STATES_MATCH_FIELD(powerups[i].x);
+        GAME_STATES_MATCH_FIELD(powerups[i].y);
+        GAME_STATES_MATCH_FIELD(powerups[i].gameTicksLeft);
+        GAME_STATES_MATCH_FIELD(powerups[i].type);
+    }
+    GAME_STATES_MATCH_FIELD(ticksToNextRound);
+    GAME_STATES_MATCH_FIELD(rand);
+    #undef GAME_STATES_MATCH_FIELD
+    return SDL_TRUE;
+}
 
-        // Ball/score-zone collisions
-        SDL_Rect ballRect;
-        Balls[i].GetRect(&ballRect);
-        for (uint8_t j = 0; j < SDL_arraysize(ScoreZones); ++j) {
-            if (SDL_HasIntersection(&ballRect, &ScoreZones[j])) {
-                // For now, just add score, then reset after a short interval
-                Scores[(j % 2) == 0]++;
-                Balls[i].type = BallTypeInactive;
-                GameTicksToNextRound = GameTicksToNextRoundDefault;
-            }
-        }
+
+//
+//     ####                                 ####                 ##
+//    #       ####  ## #    ###             #   #   ###   ####    #    ####  #   #   ####
+//    #  ##  #   #  # # #  #####            ####   #####  #   #   #   #   #  #   #  ###
+//    #   #  #  ##  # # #  #                #  #   #      #   #   #   #  ##   ####    ###
+//     ####   ## #  #   #   ###             #   #   ###   ####   ###   ## #      #  ####
+//                                                        #                   ###
+//
+// A match, recorded as its seed plus each game-tick's GameInput.  Input bits
+// rarely change from one tick to the next, so they're stored as runs of
+// identical bits.  Replaying drives GameUpdate() with the recorded input, and
+// checks the result against a hash of the recorded match's final state.
+//
+// Loaded replays get a keyframe (a GameSnapshot) every ReplayKeyframeInterval
+// game-ticks, by being played through once.  Seeking restores the nearest
+// keyframe at or before the wanted tick, then simulates forward from there, so
+// it costs the same anywhere in a match, however long.  Keyframes aren't saved
+// to replay files, so files never hold more than a seed and input.
+//
+#pragma mark - Game Replays
+
+static const char ReplayMagic[4] = {'P', 'B', 'R', 'P'};   // first 4 bytes of a replay file
+static const uint16_t ReplayVersion = 4;                   // version 1 had no keyframes; 2 had no physics mode; 2 and 3 saved keyframes (now ignored)
+static const uint16_t ReplayPhysics = PHYSICS_FIXED_POINT;  // physics mode recorded in; 0 = float, 1 = fixed-point
+static const uint32_t ReplayKeyframeInterval = 1000;        // game-ticks between keyframes
+
+struct ReplayRun {
+    uint32_t ticks;     // number of consecutive game-ticks with this input
+    GameInput input;
+};
+
+struct ReplayKeyframe {
+    GameSnapshot snapshot;  // the match, just before game-tick (keyframe # * ReplayKeyframeInterval)
+    uint32_t run;           // index of the run holding that game-tick's input
+    uint32_t ticksIntoRun;  // number of that run's game-ticks that came before it
+};
+
+struct Replay {
+    uint64_t seed;              // the match's seed, as passed to GameSeed(), before GameInit(GAME_INIT_DEFAULT)
+    uint16_t ticksPerSecond;    // TicksPerSecond, while recording; replays must be played at this rate
+    uint32_t tickCount;         // total game-ticks recorded
+    uint32_t finalHash;         // GameStateHash(), after the last recorded game-tick; set via ReplayFinish()
+    ReplayRun * runs;
+    uint32_t runCount;
+    uint32_t runCapacity;
+    ReplayKeyframe * keyframes;
+    uint32_t keyframeCount;
+    uint32_t keyframeCapacity;
+};
+
+// GameStateHash -- hashes all simulated state of a match (the same state that
+//   GameStatesMatch() compares), via 32-bit FNV-1a
+static uint32_t GameStateHash(const GameState * game)
+{
+    uint32_t hash = 2166136261u;
+    #define GAME_STATE_HASH_BYTES(PTR, SIZE) \
+        for (size_t byte = 0; byte < (SIZE); ++byte) { hash = (hash ^ ((const uint8_t *)(PTR))[byte]) * 16777619u; }
+    #define GAME_STATE_HASH_FIELD(FIELD) GAME_STATE_HASH_BYTES(&game->FIELD, sizeof(game->FIELD))
+    GAME_STATE_HASH_FIELD(ballCapacity);
+    GAME_STATE_HASH_FIELD(activeBallCount);
+    GAME_STATE_HASH_FIELD(powerupCapacity);
+    for (uint16_t i = 0; i < game->ballCapacity; ++i) {
+        GAME_STATE_HASH_FIELD(balls[i].cx);
+        GAME_STATE_HASH_FIELD(balls[i].cy);
+        GAME_STATE_HASH_FIELD(balls[i].vx);
+        GAME_STATE_HASH_FIELD(balls[i].vy);
+        GAME_STATE_HASH_FIELD(balls[i].type);
+    }
+    for (uint8_t i = 0; i < PaddleCount; ++i) {
+        GAME_STATE_HASH_FIELD(paddles[i].y);
+        GAME_STATE_HASH_FIELD(paddles[i].vy);
+        GAME_STATE_HASH_FIELD(paddles[i].cutTop);
+        GAME_STATE_HASH_FIELD(paddles[i].cutBottom);
+        GAME_STATE_HASH_FIELD(paddles[i].laserRechargeTicks);
+        GAME_STATE_HASH_FIELD(paddles[i].numCuts);
+        GAME_STATE_HASH_FIELD(paddles[i].cuts);
+        GAME_STATE_HASH_FIELD(lasers[i].cy);
+        GAME_STATE_HASH_FIELD(lasers[i].magnitude);
+        GAME_STATE_HASH_FIELD(lasers[i].gameTicksUntilCut);
+        GAME_STATE_HASH_FIELD(scores[i]);
     }
+    for (uint16_t i = 0; i < game->powerupCapacity; ++i) {
+        GAME_STATE_HASH_FIELD(powerups[i].x);
+        GAME_STATE_HASH_FIELD(powerups[i].y);
+        GAME_STATE_HASH_FIELD(powerups[i].gameTicksLeft);
+        GAME_STATE_HASH_FIELD(powerups[i].type);
+    }
+    GAME_STATE_HASH_FIELD(ticksToNextRound);
+    GAME_STATE_HASH_FIELD(rand);
+    #undef GAME_STATE_HASH_FIELD
+    #undef GAME_STATE_HASH_BYTES
+    return hash;
 }
 
+// ReplayDestroy -- frees a replay's resources
+static void ReplayDestroy(Replay * replay)
+{
+    SDL_free(replay->runs);
+    SDL_free(replay->keyframes);
+    SDL_memset(replay, 0, sizeof(Replay));
+}
 
-//   
-//     ####                              ####                       
-//    #       ####  ## #    ###          #   #  # ##    ####  #   # 
-//    #  ##  #   #  # # #  #####         #   #  ##     #   #  # # # 
-//    #   #  #  ##  # # #  #             #   #  #      #  ##  # # # 
-//     ####   ## #  #   #   ###          ####   #       ## #   # #  
-//                                                                  
-#pragma mark - Game Draw
+// ReplayBegin -- starts recording a new match, which must be seeded with
+//   'seed', then initialized with GAME_INIT_DEFAULT
+static void ReplayBegin(Replay * replay, uint64_t seed)
+{
+    ReplayDestroy(replay);
+    replay->seed = seed;
+    replay->ticksPerSecond = TicksPerSecond;
+}
 
-// GameDraw -- draws screen; SHOULD NOT ALTER GAME STATE (use GameUpdate() for that!!!)
-//   This may be called at a different interval than GameUpdate().
-//   It is NOT guaranteed to be called at a fixed rate!
-static void GameDraw()
+// ReplayAppend -- appends 'ticks' game-ticks' worth of the same input to a recording
+static SDL_bool ReplayAppend(Replay * replay, GameInput input, uint32_t ticks)
 {
-    SDL_Rect r, r2;
-    
-    // Background, Main
-    RectSet(&r, 0, 0, ScreenWidth, ScreenHeight - HUDHeight);
-//    SDL_FillRect(Screen, &r, SDL_MapRGB(Screen->format, 0xaa, 0xaa, 0xaa));
-    SDL_SetClipRect(Screen, &r);
-    r2.w = Images[ImageIDBackgroundTile]->w;
-    r2.h = Images[ImageIDBackgroundTile]->h;
-    for (uint16_t y = 0; y < r.h; y += r2.h) {
-        for (uint16_t x = 0; x < r.w; x += r2.w) {
-            r2.x = x;
-            r2.y = y;
-            SDL_BlitSurface(Images[ImageIDBackgroundTile], NULL, Screen, &r2);
+    if (ticks > UINT32_MAX - replay->tickCount) {
+        SDL_Log("%s, replay is too long", __FUNCTION__);
+        return SDL_FALSE;
+    }
+    if (replay->runCount > 0 && replay->runs[replay->runCount - 1].input.bits == input.bits) {
+        replay->runs[replay->runCount - 1].ticks += ticks;
+    } else {
+        if (replay->runCount == replay->runCapacity) {
+            const uint32_t capacity = SDL_max(replay->runCapacity * 2, 256u);
+            ReplayRun * runs = (ReplayRun *) SDL_realloc(replay->runs, capacity * sizeof(ReplayRun));
+            if ( ! runs) {
+                SDL_Log("%s, out of memory", __FUNCTION__);
+                return SDL_FALSE;
+            }
+            replay->runs = runs;
+            replay->runCapacity = capacity;
         }
+        replay->runs[replay->runCount].ticks = ticks;
+        replay->runs[replay->runCount].input = input;
+        replay->runCount++;
     }
+    replay->tickCount += ticks;
+    return SDL_TRUE;
+}
 
-    // Background, Paddle-Bars
-    r.w = Images[ImageIDBackgroundPaddleBar]->w;
-    r.h = Images[ImageIDBackgroundPaddleBar]->h;
-    for (uint8_t i = 0; i < SDL_arraysize(Paddles); ++i) {
-        r.x = PaddleXs[i] + (PaddleWidth / 2) - (r.w / 2);
-        for (int16_t y = 0; y < (ScreenHeight - HUDHeight); y += r.h) {
-            r.y = y;
-            SDL_BlitSurface(Images[ImageIDBackgroundPaddleBar], NULL, Screen, &r);
+// ReplayKeyframeNew -- appends a zeroed keyframe, returning it, or NULL if out of memory
+static ReplayKeyframe * ReplayKeyframeNew(Replay * replay)
+{
+    if (replay->keyframeCount == replay->keyframeCapacity) {
+        const uint32_t capacity = SDL_max(replay->keyframeCapacity * 2, 16u);
+        ReplayKeyframe * keyframes = (ReplayKeyframe *) SDL_realloc(replay->keyframes, capacity * sizeof(ReplayKeyframe));
+        if ( ! keyframes) {
+            SDL_Log("%s, out of memory", __FUNCTION__);
+            return NULL;
         }
+        replay->keyframes = keyframes;
+        replay->keyframeCapacity = capacity;
     }
+    ReplayKeyframe * keyframe = &replay->keyframes[replay->keyframeCount++];
+    SDL_memset(keyframe, 0, sizeof(ReplayKeyframe));
+    return keyframe;
+}
 
-    // End of Background drawing
-    SDL_SetClipRect(Screen, NULL);
-    
-    // Paddles
-    for (uint8_t i = 0; i < SDL_arraysize(Paddles); ++i) {
-#if DEBUG_PADDLE_DRAWING
-        // Highlight the paddle's vertical bounds (used when firing lasers, and
-        // for determining paddle-to-wall collisions).
-        r.x = Paddles[i].Left() - 4;
-        r.y = MathRound(Paddles[i].Top()) + Paddles[i].cutTop;
-        r.w = PaddleWidth + 8;
-        r.h = (Paddles[i].cutBottom - Paddles[i].cutTop);
-        SDL_FillRect(Screen, &r, SDL_MapRGBA(Screen->format, 0xff, 0xff, 0xff, 0x80));
-#endif
-        
-        Paddles[i].GetRect(&r);
-        SDL_BlitSurface(Paddle::GetImage(i), NULL, Screen, &r);
+// ReplayKeyframeAdd -- appends a keyframe of a match, for the game-tick at the
+//   given position in the replay's runs; keyframes must be added in order
+static SDL_bool ReplayKeyframeAdd(Replay * replay, const GameState * game, uint32_t run, uint32_t ticksIntoRun)
+{
+    ReplayKeyframe * keyframe = ReplayKeyframeNew(replay);
+    if ( ! keyframe) {
+        return SDL_FALSE;
     }
-    
-    // Powerups
-    r.w = r.h = PowerupSize;
-    for (uint8_t i = 0; i < SDL_arraysize(Powerups); ++i) {
-        if (Powerups[i].type != PowerupType_Inactive) {
-            r.x = Powerups[i].x;
-        }
-        
-        r.x = Powerups[i].x;
-        r.y = Powerups[i].y;
+    keyframe->run = run;
+    keyframe->ticksIntoRun = ticksIntoRun;
+    if ( ! GameSnapshotSave(game, &keyframe->snapshot)) {
+        replay->keyframeCount--;
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
 
-        ImageID imageID;
-        switch (Powerups[i].type) {
-            case PowerupType_Inactive:  imageID = 0;                        break;
-            case PowerupType_Plain:     imageID = ImageIDPowerupPlain;      break;
-            case PowerupType_Health:    imageID = ImageIDPowerupHealth;     break;
-            case PowerupType_AddBall:   imageID = ImageIDPowerupAddBall;    break;
-            case PowerupType_RemoveBall:imageID = ImageIDPowerupRemoveBall; break;
-            case PowerupType_Reserved1: imageID = ImageIDPowerupPlain;      break;
-            case PowerupType_Reserved2: imageID = ImageIDPowerupPlain;      break;
-            case PowerupType_Reserved3: imageID = ImageIDPowerupPlain;      break;
-            case PowerupType_Reserved4: imageID = ImageIDPowerupPlain;      break;
-            case PowerupType_Reserved5: imageID = ImageIDPowerupPlain;      break;
-            case PowerupType_Reserved6: imageID = ImageIDPowerupPlain;      break;
-            default:                    imageID = 0;                        break;
-        }
-        if (imageID) {
-            SDL_BlitSurface(Images[imageID], NULL, Screen, &r);
-        }
+// ReplayRecord -- appends one game-tick's input to a recording
+static SDL_bool ReplayRecord(Replay * replay, GameInput input)
+{
+    return ReplayAppend(replay, input, 1);
+}
+
+// ReplayFinish -- stops recording, noting the match's final state, for
+//   ReplayPlay() to check against
+static void ReplayFinish(Replay * replay, const GameState * game)
+{
+    replay->finalHash = GameStateHash(game);
+}
+
+// ReplaySave -- writes a finished recording to a file.  Run lengths are
+//   written 7 bits per byte, low bits first, with the top bit set on all but
+//   the last byte, so most runs take 2 bytes, including their input bits.
+//   Float and fixed-point builds simulate differently, so the header notes
+//   which one recorded it.
+static SDL_bool ReplaySave(const Replay * replay, const char * path)
+{
+    SDL_RWops * file = SDL_RWFromFile(path, "wb");
+    if ( ! file) {
+        SDL_Log("%s, SDL_RWFromFile failed [%s]: %s", __FUNCTION__, path, SDL_GetError());
+        return SDL_FALSE;
+    }
+    SDL_bool ok = (SDL_RWwrite(file, ReplayMagic, sizeof(ReplayMagic), 1) == 1) ? SDL_TRUE : SDL_FALSE;
+    ok = (ok &&
+          SDL_WriteLE16(file, ReplayVersion) &&
+          SDL_WriteLE16(file, replay->ticksPerSecond) &&
+          SDL_WriteLE16(file, ReplayPhysics) &&
+          SDL_WriteLE64(file, replay->seed) &&
+          SDL_WriteLE32(file, replay->tickCount) &&
+          SDL_WriteLE32(file, replay->finalHash) &&
+          SDL_WriteLE32(file, replay->runCount)) ? SDL_TRUE : SDL_FALSE;
+    for (uint32_t i = 0; ok && i < replay->runCount; ++i) {
+        uint8_t bytes[6];
+        uint8_t numBytes = 0;
+        bytes[numBytes++] = replay->runs[i].input.bits;
+        uint32_t ticks = replay->runs[i].ticks;
+        do {
+            bytes[numBytes++] = (uint8_t)((ticks & 0x7f) | ((ticks > 0x7f) ? 0x80 : 0));
+            ticks >>= 7;
+        } while (ticks > 0);
+        ok = (SDL_RWwrite(file, bytes, numBytes, 1) == 1) ? SDL_TRUE : SDL_FALSE;
     }
+    if (SDL_RWclose(file) != 0) {
+        ok = SDL_FALSE;
+    }
+    if ( ! ok) {
+        SDL_Log("%s, couldn't write replay [%s]: %s", __FUNCTION__, path, SDL_GetError());
+    }
+    return ok;
+}
 
-    // Lasers
-    for (uint8_t i = 0; i < SDL_arraysize(Lasers); ++i) {
-        if (Lasers[i].GetRect(&r, i) == 0) {
-            SDL_FillRect(Screen, &r, SDL_MapRGB(Screen->format, 0xff, 0xff, 0x00));
-        }
+// ReplayLoad -- reads a recording, as written by ReplaySave().  Keyframes
+//   saved by older versions are ignored, rather than trusted; ReplayIndex()
+//   rebuilds them.
+static SDL_bool ReplayLoad(Replay * replay, const char * path)
+{
+    ReplayDestroy(replay);
+    SDL_RWops * file = SDL_RWFromFile(path, "rb");
+    if ( ! file) {
+        SDL_Log("%s, SDL_RWFromFile failed [%s]: %s", __FUNCTION__, path, SDL_GetError());
+        return SDL_FALSE;
     }
-    
-    // Balls
-    for (uint8_t i = 0; i < SDL_arraysize(Balls); ++i) {
-        if (Balls[i].type == BallTypeInactive) {
-            continue;
-        }
-        Balls[i].GetRect(&r);
-        SDL_Surface * ballImage = Balls[i].GetImage();
-        if (ballImage) {
-            SDL_BlitSurface(ballImage, NULL, Screen, &r);
-        } else {
-            SDL_FillRect(Screen, &r, SDL_MapRGB(Screen->format, 0, 0, 0));
+    char magic[sizeof(ReplayMagic)] = {0};
+    SDL_RWread(file, magic, sizeof(magic), 1);
+    const uint16_t version = SDL_ReadLE16(file);
+    replay->ticksPerSecond = SDL_ReadLE16(file);
+    const uint16_t physics = (version >= 3) ? SDL_ReadLE16(file) : 0;
+    replay->seed = SDL_ReadLE64(file);
+    const uint32_t tickCount = SDL_ReadLE32(file);
+    replay->finalHash = SDL_ReadLE32(file);
+    const uint32_t runCount = SDL_ReadLE32(file);
+    SDL_bool ok = (SDL_memcmp(magic, ReplayMagic, sizeof(magic)) == 0 &&
+                   version >= 1 && version <= ReplayVersion &&
+                   replay->ticksPerSecond >= TicksPerSecondMin &&
+                   replay->ticksPerSecond <= TicksPerSecondMax) ? SDL_TRUE : SDL_FALSE;
+    if (ok && physics != ReplayPhysics) {
+        SDL_Log("%s, replay [%s] was recorded with %s physics; this build uses %s",
+                __FUNCTION__, path, physics ? "fixed-point" : "float", ReplayPhysics ? "fixed-point" : "float");
+        ok = SDL_FALSE;
+    }
+    for (uint32_t i = 0; ok && i < runCount; ++i) {
+        uint8_t byte = 0;
+        GameInput input;
+        ok = (SDL_RWread(file, &input.bits, 1, 1) == 1) ? SDL_TRUE : SDL_FALSE;
+        uint32_t ticks = 0;
+        for (uint8_t shift = 0; ok && shift < 32; shift += 7) {
+            ok = (SDL_RWread(file, &byte, 1, 1) == 1) ? SDL_TRUE : SDL_FALSE;
+            ticks |= (uint32_t)(byte & 0x7f) << shift;
+            if ( ! (byte & 0x80)) {
+                break;
+            }
         }
+        ok = (ok && ticks > 0 && ReplayAppend(replay, input, ticks)) ? SDL_TRUE : SDL_FALSE;
     }
+    ok = (ok && replay->tickCount == tickCount && replay->runCount == runCount) ? SDL_TRUE : SDL_FALSE;
     
-    // Scoring zones
-#if DEBUG_SCORE_ZONE_DRAWING
-    for (uint8_t i = 0; i < SDL_arraysize(ScoreZones); ++i) {
-        SDL_FillRect(Screen, &ScoreZones[i], SDL_MapRGB(Screen->format, 0x00, 0xff, 0x00));
+    SDL_RWclose(file);
+    if ( ! ok) {
+        SDL_Log("%s, not a valid replay [%s]", __FUNCTION__, path);
+        ReplayDestroy(replay);
     }
-#endif
+    return ok;
+}
+
+// ReplayPlayer -- steps through a replay's input, one game-tick at a time
+struct ReplayPlayer {
+    const Replay * replay;
+    uint32_t tick;          // number of game-ticks played so far
+    uint32_t run;           // index of the run holding the next game-tick's input
+    uint32_t ticksIntoRun;  // number of game-ticks already played from that run
     
-    // HUD
-    RectSet(&r, 0, ScreenHeight - HUDHeight, ScreenWidth, HUDHeight);
+    // Next -- gets the next game-tick's input; SDL_FALSE once the replay has ended
+    SDL_bool Next(GameInput * input) {
+        if (run >= replay->runCount) {
+            return SDL_FALSE;
+        }
+        *input = replay->runs[run].input;
+        ++tick;
+        if (++ticksIntoRun >= replay->runs[run].ticks) {
+            ++run;
+            ticksIntoRun = 0;
+        }
+        return SDL_TRUE;
+    }
+};
+
+// ReplayStart -- seeds and initializes a match, for a replay to be played into it
+static void ReplayStart(const Replay * replay, GameState * game, ReplayPlayer * player)
+{
+    GameStateReset(game);
+    GameSeed(game, replay->seed);
+    GameInit(game, GAME_INIT_DEFAULT);
+    player->replay = replay;
+    player->tick = 0;
+    player->run = 0;
+    player->ticksIntoRun = 0;
+}
+
+// ReplaySeek -- puts a match in the state it was in just before the given
+//   game-tick (or at the replay's end, for later ticks).  The match gets
+//   restored from the nearest keyframe at or before that tick, unless the
+//   player is already between the two, then simulated forward to the tick.
+static void ReplaySeek(const Replay * replay, GameState * game, ReplayPlayer * player, uint32_t tick)
+{
+    tick = SDL_min(tick, replay->tickCount);
+    if (replay->keyframeCount == 0) {
+        if (player->replay != replay || player->tick > tick) {
+            ReplayStart(replay, game, player);
+        }
+    } else {
+        const uint32_t keyframeIndex = SDL_min(tick / ReplayKeyframeInterval, replay->keyframeCount - 1);
+        const uint32_t keyframeTick = keyframeIndex * ReplayKeyframeInterval;
+        if (player->replay != replay || player->tick < keyframeTick || player->tick > tick) {
+            if (player->replay != replay) {
+                ReplayStart(replay, game, player);
+            }
+            const ReplayKeyframe * keyframe = &replay->keyframes[keyframeIndex];
+            GameSnapshotRestore(game, &keyframe->snapshot);
+            player->replay = replay;
+            player->tick = keyframeTick;
+            player->run = keyframe->run;
+            player->ticksIntoRun = keyframe->ticksIntoRun;
+        }
+    }
+    GameInput input;
+    while (player->tick < tick && player->Next(&input)) {
+        GameUpdate(game, input);
+    }
+}
+
+// ReplayIndex -- [re]builds a replay's keyframes, by playing it through once;
+//   replays loaded from files need this before they can seek quickly
+static SDL_bool ReplayIndex(Replay * replay, GameState * game)
+{
+    replay->keyframeCount = 0;
+    ReplayPlayer player;
+    ReplayStart(replay, game, &player);
+    for (uint32_t tick = 0; tick < replay->tickCount; ++tick) {
+        if ((tick % ReplayKeyframeInterval) == 0 &&
+            ! ReplayKeyframeAdd(replay, game, player.run, player.ticksIntoRun))
+        {
+            return SDL_FALSE;
+        }
+        GameInput input;
+        player.Next(&input);
+        GameUpdate(game, input);
+    }
+    return SDL_TRUE;
+}
+
+// ReplayPlay -- plays a whole replay into a match, as fast as possible, then
+//   checks that the match ended up the same as the recorded one did
+static SDL_bool ReplayPlay(const Replay * replay, GameState * game)
+{
+    if (replay->ticksPerSecond != TicksPerSecond) {
+        SDL_Log("%s, replay was recorded at %u game-ticks per second, not %u",
+                __FUNCTION__, (unsigned)replay->ticksPerSecond, (unsigned)TicksPerSecond);
+        return SDL_FALSE;
+    }
+    GameStateReset(game);
+    GameSeed(game, replay->seed);
+    GameInit(game, GAME_INIT_DEFAULT);
+    for (uint32_t i = 0; i < replay->runCount; ++i) {
+        const GameInput input = replay->runs[i].input;
+        for (uint32_t tick = 0; tick < replay->runs[i].ticks; ++tick) {
+            GameUpdate(game, input);
+        }
+    }
+    return (GameStateHash(game) == replay->finalHash) ? SDL_TRUE : SDL_FALSE;
+}
+
+
+
+//   
+//     ####                              ####                       
+//    #       ####  ## #    ###          #   #  # ##    ####  #   # 
+//    #  ##  #   #  # # #  #####         #   #  ##     #   #  # # # 
+//    #   #  #  ##  # # #  #             #   #  #      #  ##  # # # 
+//     ####   ## #  #   #   ###          ####   #       ## #   # #  
+//                                                                  
+#pragma mark - Game Draw
+
+// GameDrawItem -- one paddle, powerup, laser, or ball, as drawn into the
+//   play area.  Only items that look different from the last frame, plus
+//   whatever they overlap, get redrawn.
+struct GameDrawItem {
+    SDL_Rect rect;          // empty (w == 0) if nothing gets drawn
+    SDL_Surface * image;    // blitted to 'rect', if set...
+    uint32_t color;         // ...otherwise, 'rect' gets filled with this
+    uint32_t version;       // changes whenever the image's pixels do (as for re-rendered paddles)
+};
+
+// GameDrawUpdate -- the parts of Screen that a GameDraw() changed, to copy to ScreenTexture
+static const uint16_t GameDrawMaxDirtyRects = 64;
+static const float GameDrawMaxDirtyFraction = 0.25f;   // redraw the whole screen, instead, once more than this much of the play area is dirty
+struct GameDrawUpdate {
+    SDL_bool all;           // was the whole screen redrawn?  (if so, 'rects' is unused)
+    uint16_t count;
+    SDL_Rect rects[GameDrawMaxDirtyRects + 1];  // dirty parts of the play area, plus the HUD, if it changed
+};
+
+static SDL_Surface * GameDrawPaddleImages[PaddleCount];         // drawn paddles, re-rendered only when their cuts change
+static PaddleCutRows GameDrawPaddleCuts[PaddleCount][PaddleMaxCuts];    // cuts that GameDrawPaddleImages were rendered with
+static uint32_t GameDrawPaddleVersions[PaddleCount];            // bumped each time GameDrawPaddleImages get re-rendered
+static GameDrawItem * GameDrawItems[2];     // items drawn this frame, and last frame, alternating
+static uint32_t GameDrawItemCounts[2];
+static uint32_t GameDrawItemCapacity = 0;
+static uint8_t GameDrawCurrentItems = 0;    // index, into GameDrawItems, of this frame's items
+static uint16_t GameDrawHUDValues[PaddleCount * 2];     // scores, then laser-recharge ticks, as last drawn
+static SDL_bool GameDrawIsStale = SDL_TRUE; // SDL_TRUE to redraw the whole screen next frame, regardless of what changed
+
+// GameDrawInvalidate -- makes the next GameDraw() redraw, and update, the whole screen (for when ScreenTexture gets re-created)
+static void GameDrawInvalidate()
+{
+    GameDrawIsStale = SDL_TRUE;
+}
+
+// GameDrawGetItems -- lists everything that a match draws into the play area, in drawing order; one item per paddle, powerup, laser, and ball slot
+static uint32_t GameDrawGetItems(const GameState * game, GameDrawItem * items)
+{
+    uint32_t n = 0;
+    
+    // Paddles
+    for (uint8_t i = 0; i < PaddleCount; ++i, ++n) {
+        SDL_memset(&items[n], 0, sizeof(GameDrawItem));
+        if ( ! GameDrawPaddleImages[i]) {
+            GameDrawPaddleImages[i] = SDL_CreateRGBSurface(0, PaddleWidth, PaddleMaxH, 32, ImageRMask, ImageGMask, ImageBMask, ImageAMask);
+            if ( ! GameDrawPaddleImages[i]) {
+                SDL_Log("%s, SDL_CreateRGBSurface failed [paddle image]: %s", __FUNCTION__, SDL_GetError());
+                continue;
+            }
+            PaddleRender(&game->paddles[i], i, GameDrawPaddleImages[i]);
+            SDL_memcpy(GameDrawPaddleCuts[i], game->paddles[i].cuts, sizeof(GameDrawPaddleCuts[i]));
+            ++GameDrawPaddleVersions[i];
+        } else if (SDL_memcmp(GameDrawPaddleCuts[i], game->paddles[i].cuts, sizeof(GameDrawPaddleCuts[i])) != 0) {
+            PaddleRender(&game->paddles[i], i, GameDrawPaddleImages[i]);
+            SDL_memcpy(GameDrawPaddleCuts[i], game->paddles[i].cuts, sizeof(GameDrawPaddleCuts[i]));
+            ++GameDrawPaddleVersions[i];
+        }
+        game->paddles[i].GetRect(&items[n].rect);
+        items[n].image = GameDrawPaddleImages[i];
+        items[n].version = GameDrawPaddleVersions[i];
+    }
+    
+    // Powerups
+    for (uint16_t i = 0; i < game->powerupCapacity; ++i, ++n) {
+        SDL_memset(&items[n], 0, sizeof(GameDrawItem));
+        ImageID imageID;
+        switch (game->powerups[i].type) {
+            case PowerupType_Inactive:  imageID = 0;                        break;
+            case PowerupType_Plain:     imageID = ImageIDPowerupPlain;      break;
+            case PowerupType_Health:    imageID = ImageIDPowerupHealth;     break;
+            case PowerupType_AddBall:   imageID = ImageIDPowerupAddBall;    break;
+            case PowerupType_RemoveBall:imageID = ImageIDPowerupRemoveBall; break;
+            case PowerupType_Reserved1: imageID = ImageIDPowerupPlain;      break;
+            case PowerupType_Reserved2: imageID = ImageIDPowerupPlain;      break;
+            case PowerupType_Reserved3: imageID = ImageIDPowerupPlain;      break;
+            case PowerupType_Reserved4: imageID = ImageIDPowerupPlain;      break;
+            case PowerupType_Reserved5: imageID = ImageIDPowerupPlain;      break;
+            case PowerupType_Reserved6: imageID = ImageIDPowerupPlain;      break;
+            default:                    imageID = 0;                        break;
+        }
+        if (imageID) {
+            RectSet(&items[n].rect, game->powerups[i].x, game->powerups[i].y, PowerupSize, PowerupSize);
+            items[n].image = Images[imageID];
+        }
+    }
+    
+    // Lasers
+    for (uint8_t i = 0; i < PaddleCount; ++i, ++n) {
+        SDL_memset(&items[n], 0, sizeof(GameDrawItem));
+        if (game->lasers[i].GetRect(&items[n].rect, i, game->paddles) == 0) {
+            items[n].color = SDL_MapRGB(Screen->format, 0xff, 0xff, 0x00);
+        } else {
+            items[n].rect.w = 0;
+        }
+    }
+    
+    // Balls
+    for (uint16_t i = 0; i < game->ballCapacity; ++i, ++n) {
+        SDL_memset(&items[n], 0, sizeof(GameDrawItem));
+        if (game->balls[i].type == BallTypeInactive) {
+            continue;
+        }
+        game->balls[i].GetRect(&items[n].rect);
+        items[n].image = game->balls[i].GetImage();
+        if ( ! items[n].image) {
+            items[n].color = SDL_MapRGB(Screen->format, 0, 0, 0);
+        }
+    }
+    
+    return n;
+}
+
+// GameDrawItemsMatch -- do two items look the same, in the same place?
+static SDL_bool GameDrawItemsMatch(const GameDrawItem * a, const GameDrawItem * b)
+{
+    if (a->rect.w == 0 || b->rect.w == 0) {
+        return (a->rect.w == b->rect.w) ? SDL_TRUE : SDL_FALSE;
+    }
+    return (a->rect.x == b->rect.x && a->rect.y == b->rect.y && a->rect.w == b->rect.w && a->rect.h == b->rect.h &&
+            a->image == b->image && a->color == b->color && a->version == b->version) ? SDL_TRUE : SDL_FALSE;
+}
+
+// GameDrawItemDraw -- draws one item to the screen, within its clip rect
+static void GameDrawItemDraw(const GameDrawItem * item)
+{
+    SDL_Rect r = item->rect;
+    if (r.w == 0) {
+        return;
+    } else if (item->image) {
+        SDL_BlitSurface(item->image, NULL, Screen, &r);
+    } else {
+        SDL_FillRect(Screen, &r, item->color);
+    }
+}
+
+// GameDrawDirtyAdd -- marks part of the play area as needing a redraw,
+//   merging it with any dirty rects it overlaps
+static void GameDrawDirtyAdd(GameDrawUpdate * update, SDL_Rect rect)
+{
+    const SDL_Rect playArea = { 0, 0, ScreenWidth, ScreenHeight - HUDHeight };
+    if (update->all || ! SDL_IntersectRect(&rect, &playArea, &rect)) {
+        return;
+    }
+    for (uint16_t i = 0; i < update->count; ) {
+        if (SDL_HasIntersection(&rect, &update->rects[i])) {
+            SDL_UnionRect(&rect, &update->rects[i], &rect);
+            update->rects[i] = update->rects[--update->count];
+            i = 0;      // the merged rect may now overlap ones already checked
+        } else {
+            ++i;
+        }
+    }
+    if (update->count >= GameDrawMaxDirtyRects) {
+        update->all = SDL_TRUE;
+        return;
+    }
+    update->rects[update->count++] = rect;
+}
+
+// GameDrawHUD -- draws the HUD: scores, and laser-recharge bars
+static void GameDrawHUD(const GameState * game)
+{
+    SDL_Rect r;
+    RectSet(&r, 0, ScreenHeight - HUDHeight, ScreenWidth, HUDHeight);
     SDL_FillRect(Screen, &r, SDL_MapRGB(Screen->format, 0xdd, 0xdd, 0xdd));
     
-    TextDraw(FontIDHUDScores, 0x00, 0x00, 0x00, HUDScoresXOffsets[0], (ScreenHeight - HUDHeight + HUDScoresYOffset), "Score: %d", Scores[0]);
-    TextDraw(FontIDHUDScores, 0x00, 0x00, 0x00, HUDScoresXOffsets[1], (ScreenHeight - HUDHeight + HUDScoresYOffset), "Score: %d", Scores[1]);
+    TextDrawCached(FontIDHUDScores, 0x00, 0x00, 0x00, 0xdd, 0xdd, 0xdd, HUDScoresXOffsets[0], (ScreenHeight - HUDHeight + HUDScoresYOffset), "Score: %d", game->scores[0]);
+    TextDrawCached(FontIDHUDScores, 0x00, 0x00, 0x00, 0xdd, 0xdd, 0xdd, HUDScoresXOffsets[1], (ScreenHeight - HUDHeight + HUDScoresYOffset), "Score: %d", game->scores[1]);
 
-    // HUD, Laser-recharge(s)
-    for (uint8_t i = 0; i < SDL_arraysize(Paddles); ++i) {
-//        uint16_t ticks = PaddleDefaultLaserRechargeTicks / 2;     // uncomment to debug recharge-bar appearance
-        uint16_t ticks = Paddles[i].laserRechargeTicks;
+    // Laser-recharge(s)
+    for (uint8_t i = 0; i < SDL_arraysize(game->paddles); ++i) {
+//        uint16_t ticks = TimingSecondsToTicks(PaddleDefaultLaserRechargeTime) / 2;     // uncomment to debug recharge-bar appearance
+        uint16_t ticks = game->paddles[i].laserRechargeTicks;
         if (ticks > 0) {
             // Set starting values:
             r.y = ScreenHeight - HUDHeight + ((HUDHeight - HUDLaserRechargeHeight) / 2);
@@ -1508,12 +3662,129 @@ static void GameDraw()
             r.y++;
             r.w -= 2;
             r.h -= 2;
-            r.w = MathRound((float)r.w * ((float)ticks / (float)PaddleDefaultLaserRechargeTicks));
+            r.w = MathRound((float)r.w * ((float)ticks / (float)TimingSecondsToTicks(PaddleDefaultLaserRechargeTime)));
             SDL_FillRect(Screen, &r, barColor);
         }
     }
 }
 
+// GameDraw -- draws a match to the screen; SHOULD NOT ALTER GAME STATE (use GameUpdate() for that!!!)
+//   This may be called at a different interval than GameUpdate().
+//   It is NOT guaranteed to be called at a fixed rate!
+//   Only what changed since the last call gets redrawn, as listed in 'update'.
+static void GameDraw(const GameState * game, GameDrawUpdate * update)
+{
+    update->all = GameDrawIsStale;
+    update->count = 0;
+    
+    // List what gets drawn, this frame
+    const uint32_t numItems = PaddleCount + game->powerupCapacity + PaddleCount + game->ballCapacity;
+    if (numItems > GameDrawItemCapacity) {
+        for (uint8_t i = 0; i < 2; ++i) {
+            GameDrawItem * items = (GameDrawItem *) SDL_realloc(GameDrawItems[i], numItems * sizeof(GameDrawItem));
+            if ( ! items) {
+                SDL_Log("%s, out of memory", __FUNCTION__);
+                update->all = SDL_FALSE;
+                return;
+            }
+            GameDrawItems[i] = items;
+        }
+        GameDrawItemCapacity = numItems;
+    }
+    GameDrawItem * items = GameDrawItems[GameDrawCurrentItems];
+    const GameDrawItem * lastItems = GameDrawItems[GameDrawCurrentItems ^ 1];
+    GameDrawItemCounts[GameDrawCurrentItems] = GameDrawGetItems(game, items);
+    if (GameDrawItemCounts[GameDrawCurrentItems] != GameDrawItemCounts[GameDrawCurrentItems ^ 1]) {
+        update->all = SDL_TRUE;
+    }
+#if DEBUG_PADDLE_DRAWING || DEBUG_SCORE_ZONE_DRAWING
+    update->all = SDL_TRUE;     // debug drawing isn't tracked as items
+#endif
+    
+    // Work out which parts of the play area changed: wherever an item was
+    // last frame, and is now, if it moved or changed its look
+    uint32_t dirtyArea = 0;
+    for (uint32_t i = 0; i < numItems && ! update->all; ++i) {
+        if ( ! GameDrawItemsMatch(&items[i], &lastItems[i])) {
+            GameDrawDirtyAdd(update, lastItems[i].rect);
+            GameDrawDirtyAdd(update, items[i].rect);
+        }
+    }
+    for (uint16_t i = 0; i < update->count; ++i) {
+        dirtyArea += update->rects[i].w * update->rects[i].h;
+    }
+    if (dirtyArea > (uint32_t)(GameDrawMaxDirtyFraction * (float)(ScreenWidth * (ScreenHeight - HUDHeight)))) {
+        update->all = SDL_TRUE;
+    }
+    
+    if (update->all) {
+        // Background.  Rows of the screen and background line up end-to-end,
+        // so this is usually one memcpy.
+        update->count = 0;
+        if (Screen->pitch == GameBackground->pitch && ! SDL_MUSTLOCK(Screen)) {
+            SDL_memcpy(Screen->pixels, GameBackground->pixels, GameBackground->pitch * GameBackground->h);
+        } else {
+            SDL_BlitSurface(GameBackground, NULL, Screen, NULL);
+        }
+        
+#if DEBUG_PADDLE_DRAWING
+        // Highlight the paddles' vertical bounds (used when firing lasers, and
+        // for determining paddle-to-wall collisions).
+        for (uint8_t i = 0; i < PaddleCount; ++i) {
+            SDL_Rect r;
+            r.x = game->paddles[i].Left() - 4;
+            r.y = MathRound(game->paddles[i].Top()) + game->paddles[i].cutTop;
+            r.w = PaddleWidth + 8;
+            r.h = (game->paddles[i].cutBottom - game->paddles[i].cutTop);
+            SDL_FillRect(Screen, &r, SDL_MapRGBA(Screen->format, 0xff, 0xff, 0xff, 0x80));
+        }
+#endif
+        
+        // Paddles, powerups, lasers, then balls
+        for (uint32_t i = 0; i < numItems; ++i) {
+            GameDrawItemDraw(&items[i]);
+        }
+        
+        // Scoring zones
+#if DEBUG_SCORE_ZONE_DRAWING
+        for (uint8_t i = 0; i < SDL_arraysize(ScoreZones); ++i) {
+            SDL_FillRect(Screen, &ScoreZones[i], SDL_MapRGB(Screen->format, 0x00, 0xff, 0x00));
+        }
+#endif
+    } else {
+        // Redraw each dirty rect from scratch: background, then every item
+        // that overlaps it, clipped to it
+        for (uint16_t i = 0; i < update->count; ++i) {
+            SDL_Rect r = update->rects[i];
+            SDL_SetClipRect(Screen, &update->rects[i]);
+            SDL_BlitSurface(GameBackground, &update->rects[i], Screen, &r);
+            for (uint32_t j = 0; j < numItems; ++j) {
+                if (items[j].rect.w != 0 && SDL_HasIntersection(&items[j].rect, &update->rects[i])) {
+                    GameDrawItemDraw(&items[j]);
+                }
+            }
+        }
+        SDL_SetClipRect(Screen, NULL);
+    }
+    
+    // HUD, if any of its values changed
+    uint16_t hudValues[PaddleCount * 2];
+    for (uint8_t i = 0; i < PaddleCount; ++i) {
+        hudValues[i] = game->scores[i];
+        hudValues[PaddleCount + i] = game->paddles[i].laserRechargeTicks;
+    }
+    if (update->all || SDL_memcmp(hudValues, GameDrawHUDValues, sizeof(hudValues)) != 0) {
+        GameDrawHUD(game);
+        SDL_memcpy(GameDrawHUDValues, hudValues, sizeof(hudValues));
+        if ( ! update->all) {
+            RectSet(&update->rects[update->count++], 0, ScreenHeight - HUDHeight, ScreenWidth, HUDHeight);
+        }
+    }
+    
+    GameDrawIsStale = SDL_FALSE;
+    GameDrawCurrentItems ^= 1;
+}
+
 
 //   
 //      #                 
@@ -1539,7 +3810,49 @@ static SDL_Window * Window = 0;                     // platform-native window (o
 static SDL_Renderer * Renderer = 0;                 // platform-native renderer (use WebGL on Emscripten, OpenGL on OSX, D3D on Windows, etc.)
 static SDL_Texture * ScreenTexture = 0;             // 'Screen' surface gets copied here, once per draw ; used for window-scaling
 static uint8_t AppRunning = 1;                      // 1 for running, 0 for dead-app
-static uint32_t NextGameTickAt = 0;                 // When will the next game-tick occur, as measured in milliseconds, and compared against SDL_GetTicks()
+static uint64_t NextGameTickAt = 0;                 // When will the next game-tick occur, as measured in SDL_GetPerformanceCounter() units
+static uint32_t NextGameTickRemainder = 0;          // Fraction of a performance-counter unit, in 1/TicksPerSecond's, carried between game-ticks
+static const float AppFrameBudget = 0.1f;           // Most time, in seconds, that one AppUpdate() should spend on game-ticks and drawing
+static const float AppMaxCatchUpTime = 0.25f;       // Most game-time, in seconds, that one AppUpdate() will catch up on; ticks owed beyond this get dropped
+static const float AppGovernorSmoothing = 0.1f;     // How quickly measured costs move towards new samples (0 to 1)
+static const uint8_t AppMaxSkippedFramesInRow = 3;  // While overloaded, still draw at least once per this many skipped frames
+static uint8_t AppFrameSkip = 1;                    // 1 to skip drawing while overloaded (disable via '--no-frame-skip')
+static uint8_t AppDrawIntoTexture = 0;              // 1 to draw straight into ScreenTexture's locked pixels, with no separate 'Screen' surface to copy from (set via '--lock-texture')
+struct AppGovernor {
+    float tickCost;                 // recent average time, in seconds, of one GameUpdate()
+    float drawCost;                 // recent average time, in seconds, of one GameDraw(), plus copying it to the renderer
+    uint64_t droppedTicks;          // total game-ticks dropped, rather than caught up on
+    uint64_t skippedFrames;         // total frames not drawn, while overloaded
+    uint8_t skippedFramesInRow;
+    SDL_bool overloaded;            // did the last AppUpdate() have to drop game-ticks?
+};
+static AppGovernor Governor;                        // Keeps AppUpdate() from falling ever-further behind, after stalls or on slow machines
+static uint8_t AppHeadless = 0;                     // 1 to run game-ticks as fast as possible, without a window, renderer, or drawing (set via '--headless')
+static uint32_t AppHeadlessTicks = 1000000;         // number of game-ticks to run, per match, when headless (set via '--headless [ticks]')
+static uint32_t AppHeadlessMatches = 1;             // number of independent matches to run, when headless (set via '--matches N')
+static uint32_t AppHeadlessThreads = 0;             // number of threads to spread headless matches across; 0 for 1, or for one per CPU core in tournaments (set via '--threads N')
+static uint32_t AppBenchCollisions = 0;             // number of ball collision tests to benchmark, if any (set via '--bench-collisions [N]')
+static uint32_t AppCheckSweep = 0;                  // number of fast balls to fire at paddles, when checking that they bounce, if any (set via '--check-sweep [N]')
+static uint32_t AppBenchText = 0;                   // number of strings to draw, when benchmarking text-drawing, if any (set via '--bench-text [N]')
+static const uint8_t AppBenchTextMaxLength = 16;
+static uint32_t AppStressTicks = 0;                 // number of game-ticks per stress test, if any (set via '--stress [ticks]')
+static uint32_t AppSnapshotTicks = 0;               // number of game-ticks to run the snapshot benchmark for, if any (set via '--bench-snapshots [ticks]')
+static uint32_t AppTournamentMatches = 0;           // number of bot-vs-bot matches to play in a tournament, if any (set via '--tournament [matches]')
+static const uint16_t AppTournamentWinningScore = 11;   // tournament matches end once either paddle has this many points...
+static const float AppTournamentMaxMatchTime = 600.f;   // ...or after this many seconds of gameplay, as a draw
+static const char * AppReportPath = NULL;           // file to write a tournament's results to: a summary, if it ends in '.json', or one CSV row per match (set via '--report FILE')
+static const uint16_t AppStressBallCounts[] = {10, 100, 1000, 10000};
+static const uint16_t AppStressPowerupCapacity = 256;
+static uint64_t AppSeed = 0;                        // random number seed for the match (set via '--seed N'; otherwise picked from the clock)
+static uint8_t AppSeedGiven = 0;                    // 1 if AppSeed was set via '--seed N' (any N, 0 included)
+static uint8_t AppAIPaddles = 0;                    // 1 bit per paddle for the AI to control, in all matches (set via '--ai [left|right|both]')
+static const char * AppRecordPath = NULL;           // file to record the match to, if any (set via '--record FILE')
+static const char * AppPlayPath = NULL;             // replay file to play, instead of taking input from the keyboard (set via '--play FILE')
+static Replay AppRecording;                         // the match being recorded, if AppRecordPath is set
+static Replay AppPlayback;                          // the replay being played, if AppPlayPath is set
+static ReplayPlayer AppPlaybackPlayer;
+static const float AppPlaybackSeekTime = 5.f;       // seconds to skip forward or back, per arrow-key press, while playing a replay
+static const uint16_t AppSeekTests = 1000;          // number of random seeks to time, when playing a replay headless
 
 // AppTexturesReload -- reloads GPU textures, of which there are few, as almost all content is rendered in software, by the main CPU
 static uint8_t AppTexturesReload()
@@ -1550,23 +3863,113 @@ static uint8_t AppTexturesReload()
     }
     
     if ( ! ScreenTexture) {
-        ScreenTexture = SDL_CreateTexture(Renderer, Screen->format->format, SDL_TEXTUREACCESS_STREAMING, ScreenWidth, ScreenHeight);
+        ScreenTexture = SDL_CreateTexture(Renderer, SDL_MasksToPixelFormatEnum(32, ImageRMask, ImageGMask, ImageBMask, ImageAMask), SDL_TEXTUREACCESS_STREAMING, ScreenWidth, ScreenHeight);
         if ( ! ScreenTexture) {
             SDL_Log("%s, SDL_CreateTexture failed [Screen Texture]: %s", __FUNCTION__, SDL_GetError());
             return -1;
         }
+        GameDrawInvalidate();
     }
     
     return 0;
 }
 
+// AppScreenCreate -- creates the 'Screen' surface, that frames get drawn into, before being copied to ScreenTexture
+static uint8_t AppScreenCreate()
+{
+    // Be sure to use the same color-channel settings as other images.  Not doing
+    // so can cause SDL to use slower blitters, which can have a significant
+    // impact on Emscripten performance.
+    Screen = SDL_CreateRGBSurface(0, ScreenWidth, ScreenHeight, 32, ImageRMask, ImageGMask, ImageBMask, ImageAMask);
+    if ( ! Screen) {
+        SDL_Log("%s, SDL_CreateRGBSurface failed [screen creation]: %s", __FUNCTION__, SDL_GetError());
+        return -1;
+    }
+    return 0;
+}
+
+// AppDrawLocked -- draws a frame straight into ScreenTexture, by locking it,
+//   then wrapping its pixels in a temporary 'Screen' surface.  Locked pixels
+//   start out undefined, so the whole frame gets redrawn.  Returns SDL_FALSE
+//   if the texture couldn't be locked.
+static SDL_bool AppDrawLocked()
+{
+    void * pixels;
+    int pitch;
+    if (SDL_LockTexture(ScreenTexture, NULL, &pixels, &pitch) != 0) {
+        SDL_Log("%s, SDL_LockTexture failed: %s", __FUNCTION__, SDL_GetError());
+        return SDL_FALSE;
+    }
+    Screen = SDL_CreateRGBSurfaceFrom(pixels, ScreenWidth, ScreenHeight, 32, pitch, ImageRMask, ImageGMask, ImageBMask, ImageAMask);
+    if (Screen) {
+        GameDrawUpdate update;
+        GameDrawInvalidate();
+        GameDraw(&Game, &update);
+        SDL_FreeSurface(Screen);
+        Screen = NULL;
+    } else {
+        SDL_Log("%s, SDL_CreateRGBSurfaceFrom failed: %s", __FUNCTION__, SDL_GetError());
+    }
+    SDL_UnlockTexture(ScreenTexture);
+    return SDL_TRUE;
+}
+
+// AppGovernorMeasure -- folds one duration, in performance-counter units, into
+//   a running average, in seconds.  Samples over twice the average count as
+//   twice the average, so that one stall (say, the process getting suspended
+//   mid-tick) can't throttle catch-up for many frames afterwards.
+static void AppGovernorMeasure(float * average, uint64_t counts, uint64_t frequency)
+{
+    const float seconds = (float)counts / (float)frequency;
+    if (*average == 0.f) {
+        *average = seconds;
+    } else {
+        *average += (SDL_min(seconds, *average * 2.f) - *average) * AppGovernorSmoothing;
+    }
+}
+
+// AppNextGameTickAdvance -- moves NextGameTickAt forward by one game-tick
+static void AppNextGameTickAdvance(uint64_t frequency)
+{
+    NextGameTickAt += frequency / TicksPerSecond;
+    NextGameTickRemainder += (uint32_t)(frequency % TicksPerSecond);
+    if (NextGameTickRemainder >= TicksPerSecond) {
+        NextGameTickRemainder -= TicksPerSecond;
+        NextGameTickAt++;
+    }
+}
+
+// AppPlaybackSeek -- jumps the replay being played to a game-tick
+static void AppPlaybackSeek(uint32_t tick)
+{
+    ReplaySeek(&AppPlayback, &Game, &AppPlaybackPlayer, tick);
+    if (NextGameTickAt == UINT64_MAX) {
+        NextGameTickAt = 0;     // resume game-ticks, if the replay had ended
+    }
+}
+
+// AppPlaybackIndex -- builds keyframes for AppPlayback, if it has none yet
+static SDL_bool AppPlaybackIndex()
+{
+    if (AppPlayback.keyframeCount > 0 || AppPlayback.tickCount == 0) {
+        return SDL_TRUE;
+    }
+    GameState game;
+    if ( ! GameStateCreate(&game, BallDefaultCapacity, PowerupDefaultCapacity)) {
+        return SDL_FALSE;
+    }
+    const SDL_bool indexed = ReplayIndex(&AppPlayback, &game);
+    GameStateDestroy(&game);
+    return indexed;
+}
+
 // AppUpdate -- called frequently, typically many times per second, often at monitor's refresh rate
 static void AppUpdate()
 {
     DebugGameTickCount++;
     
     // Make note of the app's current time
-    uint32_t tick = SDL_GetTicks();
+    const uint64_t tick = SDL_GetPerformanceCounter();
     
     // Cycle *ALL* SDL events.  This is necessary for many platforms.
     // (SDL_PollEvent() will often, but not always, pump OS-level events.)
@@ -1586,6 +3989,21 @@ static void AppUpdate()
                     exit(1);
                 }
             } break;
+                
+            case SDL_KEYDOWN: {
+                // Scrub through replays with the arrow keys
+                if (AppPlayPath) {
+                    const uint32_t step = TimingSecondsToTicks(AppPlaybackSeekTime);
+                    const uint32_t now = AppPlaybackPlayer.tick;
+                    if (event.key.keysym.sym == SDLK_LEFT) {
+                        AppPlaybackSeek((now > step) ? (now - step) : 0);
+                    } else if (event.key.keysym.sym == SDLK_RIGHT) {
+                        AppPlaybackSeek(now + step);
+                    } else if (event.key.keysym.sym == SDLK_HOME) {
+                        AppPlaybackSeek(0);
+                    }
+                }
+            } break;
         }
         
         // Let the game handle event(s), as needed.
@@ -1598,26 +4016,89 @@ static void AppUpdate()
     if (NextGameTickAt == 0) {
         NextGameTickAt = tick;
     }
-    while (tick >= NextGameTickAt) {
-        GameUpdate();
-        NextGameTickAt += 10;
+    const GameInput input = GameInputFromKeyboard(&Game);
+    const uint64_t frequency = SDL_GetPerformanceFrequency();
+    
+    // Catch up on owed game-ticks, but only as many as fit in the frame's
+    // budget.  Running every owed tick, after a stall (or on a machine that
+    // can't keep up), makes the frame take longer, which leaves yet more
+    // ticks owed on the next frame, and so on.
+    int maxTicks = TimingSecondsToTicks(AppMaxCatchUpTime);
+    if (Governor.tickCost > 0.f) {
+        const int affordable = (int)((AppFrameBudget - Governor.drawCost) / Governor.tickCost);
+        maxTicks = SDL_max(1, SDL_min(maxTicks, affordable));
+    }
+    for (int i = 0; (i < maxTicks) && (tick >= NextGameTickAt); ++i) {
+        GameInput tickInput = GameInputFromAI(&Game, input);
+        if (AppPlayPath && ! AppPlaybackPlayer.Next(&tickInput)) {
+            // The replay is over.  Check it, then stop running game-ticks.
+            SDL_Log("Replay ended after %u game-ticks; final state %s", AppPlayback.tickCount,
+                    (GameStateHash(&Game) == AppPlayback.finalHash) ? "matches" : "DIFFERS");
+            NextGameTickAt = UINT64_MAX;
+            break;
+        }
+        if (AppRecordPath) {
+            ReplayRecord(&AppRecording, tickInput);
+        }
+        const uint64_t startedAt = SDL_GetPerformanceCounter();
+        GameUpdate(&Game, tickInput);
+        AppGovernorMeasure(&Governor.tickCost, SDL_GetPerformanceCounter() - startedAt, frequency);
+        AppNextGameTickAdvance(frequency);
+    }
+    
+    // Drop any ticks still owed, and resume ticking from the present
+    Governor.overloaded = (tick >= NextGameTickAt) ? SDL_TRUE : SDL_FALSE;
+    if (Governor.overloaded) {
+        Governor.droppedTicks += (((tick - NextGameTickAt) * TicksPerSecond) / frequency) + 1;
+        NextGameTickAt = tick;
+        NextGameTickRemainder = 0;
+        AppNextGameTickAdvance(frequency);
+    }
+    
+    // Skip drawing while overloaded, if allowed, though not for so long that
+    // the display looks frozen
+    if (Governor.overloaded && AppFrameSkip && (Governor.skippedFramesInRow < AppMaxSkippedFramesInRow)) {
+        Governor.skippedFrames++;
+        Governor.skippedFramesInRow++;
+        return;
+    }
+    Governor.skippedFramesInRow = 0;
+    
+    const uint64_t drawStartedAt = SDL_GetPerformanceCounter();
+    if (AppDrawIntoTexture && ! AppDrawLocked()) {
+        // Fall back to drawing into a separate surface, from now on
+        AppDrawIntoTexture = 0;
+        if (AppScreenCreate() != 0) {
+            exit(1);
+        }
+    }
+    if ( ! AppDrawIntoTexture) {
+        // Draw, then copy what changed, of Screen, to the texture
+        GameDrawUpdate update;
+        GameDraw(&Game, &update);
+        if (update.all) {
+            SDL_UpdateTexture(ScreenTexture, NULL, Screen->pixels, Screen->pitch);
+        } else {
+            for (uint16_t i = 0; i < update.count; ++i) {
+                const SDL_Rect * r = &update.rects[i];
+                SDL_UpdateTexture(ScreenTexture, r, (const uint8_t *)Screen->pixels + (r->y * Screen->pitch) + (r->x * Screen->format->BytesPerPixel), Screen->pitch);
+            }
+        }
     }
-    GameDraw();
 
-    // Copy Screen to a texture, then draw the texture to the display, scaling
-    // as appropriate.
+    // Draw the texture to the display, scaling as appropriate
     SDL_SetRenderDrawColor(Renderer, 0, 0, 0, 0);
     SDL_RenderClear(Renderer);
-    SDL_UpdateTexture(ScreenTexture, NULL, Screen->pixels, Screen->pitch);
     SDL_RenderCopy(Renderer, ScreenTexture, NULL, NULL);
+    
+    // Leave presenting out of the draw's cost, as it may wait on vsync
+    AppGovernorMeasure(&Governor.drawCost, SDL_GetPerformanceCounter() - drawStartedAt, frequency);
     SDL_RenderPresent(Renderer);
 }
 
 // AppInit -- performs one-time app initialization
 static uint8_t AppInit()
 {
-    srand((unsigned int)time(0));     // Seed C-standard random number generator
-    
     SDL_SetHint("SDL_HINT_RENDER_VSYNC", "1");
     
     if (SDL_Init(SDL_INIT_VIDEO) != 0) {
@@ -1639,26 +4120,1131 @@ static uint8_t AppInit()
         return -1;
     }
 
-    // Be sure to use the same color-channel settings as other images.  Not doing
-    // so can cause SDL to use slower blitters, which can have a significant
-    // impact on Emscripten performance.
-    Screen = SDL_CreateRGBSurface(0, ScreenWidth, ScreenHeight, 32, ImageRMask, ImageGMask, ImageBMask, ImageAMask);
-    if ( ! Screen) {
-        SDL_Log("%s, SDL_CreateRGBSurface failed [screen creation]: %s", __FUNCTION__, SDL_GetError());
+    if (AppTexturesReload() != 0) {
+        return -1;
+    }
+    if ( ! AppDrawIntoTexture && AppScreenCreate() != 0) {
         return -1;
     }
     
-    if (AppTexturesReload() != 0) {
+    return 0;
+}
+
+// AppInitHeadless -- performs one-time app initialization, for use without a window or renderer
+static uint8_t AppInitHeadless()
+{
+    if (SDL_Init(SDL_INIT_TIMER) != 0) {
+        SDL_Log("%s, SDL_Init(SDL_INIT_TIMER) failed: %s", __FUNCTION__, SDL_GetError());
         return -1;
     }
     
     return 0;
 }
 
+// AppHeadlessWorker -- one thread's share of the matches, in a headless run
+struct AppHeadlessWorker {
+    GameState * games;          // first match to update
+    uint32_t count;             // number of matches to update
+    double seconds;             // time taken, as measured by the worker
+};
+
+// AppHeadlessWorkerRun -- runs all game-ticks, for all of a worker's matches
+static int AppHeadlessWorkerRun(void * data)
+{
+    AppHeadlessWorker * worker = (AppHeadlessWorker *) data;
+    const GameInput input = {0};
+    const uint64_t start = SDL_GetPerformanceCounter();
+    for (uint32_t m = 0; m < worker->count; ++m) {
+        for (uint32_t i = 0; i < AppHeadlessTicks; ++i) {
+            GameUpdate(&worker->games[m], GameInputFromAI(&worker->games[m], input));
+        }
+    }
+    const uint64_t end = SDL_GetPerformanceCounter();
+    worker->seconds = (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+    return 0;
+}
+
+// AppScriptedInput -- makes up some deterministic, but varied, input for a match's
+//   paddles.  Each paddle holds a random combination of keys for 64 game-ticks.
+static GameInput AppScriptedInput(uint32_t match, uint32_t tick)
+{
+    uint32_t h = (match * 0x9E3779B9u) ^ ((tick / 64) * 0x85EBCA6Bu);
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    GameInput input;
+    input.bits = (uint8_t)(h & ((1 << (GameInputBitsPerPaddle * PaddleCount)) - 1));
+    return input;
+}
+
+// AppRunCollisionBenchmark -- times mask-based ball collision tests against their
+//   pixel-by-pixel references, using randomly-placed balls, near randomly-cut
+//   paddles and randomly-placed powerups, and checks that both agree.
+static int AppRunCollisionBenchmark()
+{
+    const uint32_t numTests = AppBenchCollisions;
+    GameState * game = (GameState *) SDL_calloc(1, sizeof(GameState));
+    Ball * balls = (Ball *) SDL_calloc(numTests, sizeof(Ball));
+    if ( ! game || ! balls || ! GameStateCreate(game, BallDefaultCapacity, PowerupDefaultCapacity)) {
+        SDL_Log("%s, out of memory", __FUNCTION__);
+        SDL_free(balls);
+        SDL_free(game);
+        return 1;
+    }
+    GameSeed(game, AppSeed);
+    GameInit(game, GAME_INIT_DEFAULT);
+    
+    // Cut some random rows out of the paddles
+    Rand rand;
+    rand.Seed(AppSeed);
+    for (uint8_t i = 0; i < PaddleCount; ++i) {
+        for (uint8_t j = 0; j < 4; ++j) {
+            const int16_t top = (int16_t) MathRandRangeI(&rand, 0, PaddleMaxH - 1);
+            const int16_t height = (int16_t) MathRandRangeI(&rand, 1, 14);
+            PaddleCut(&game->paddles[i], i, top, SDL_min(top + height, PaddleMaxH));
+        }
+    }
+    
+    // The pixel-by-pixel paddle tests need the paddles drawn out
+    SDL_Surface * paddleImages[PaddleCount];
+    for (uint8_t i = 0; i < PaddleCount; ++i) {
+        paddleImages[i] = SDL_CreateRGBSurface(0, PaddleWidth, PaddleMaxH, 32, ImageRMask, ImageGMask, ImageBMask, ImageAMask);
+        if ( ! paddleImages[i]) {
+            SDL_Log("%s, SDL_CreateRGBSurface failed [paddle image]: %s", __FUNCTION__, SDL_GetError());
+            for (uint8_t j = 0; j < i; ++j) {
+                SDL_FreeSurface(paddleImages[j]);
+            }
+            SDL_free(balls);
+            GameStateDestroy(game);
+            SDL_free(game);
+            return 1;
+        }
+        PaddleRender(&game->paddles[i], i, paddleImages[i]);
+    }
+    
+    // Make balls that are close to, and often overlapping, a paddle (in even
+    // tests) or powerup 0 (in odd tests)
+    game->powerups[0].type = PowerupType_Plain;
+    for (uint32_t i = 0; i < numTests; ++i) {
+        SDL_Rect target;
+        if (i % 2) {
+            game->powerups[0].GetRect(&target);
+        } else {
+            game->paddles[(i / 2) % PaddleCount].GetRect(&target);
+        }
+        balls[i].cx = MathRandRangeF(&rand, target.x - BallSize, target.x + target.w + BallSize);
+        balls[i].cy = MathRandRangeF(&rand, target.y - BallSize, target.y + target.h + BallSize);
+        balls[i].type = (BallType) MathRandRangeI(&rand, BallTypeNoPlayer, BallTypeRed);
+    }
+    
+    SDL_Log("Running %u ball collision tests, with seed %llu...", numTests, (unsigned long long)AppSeed);
+    uint32_t hits[2] = {0, 0};
+    double seconds[2] = {0.0, 0.0};
+    uint32_t mismatches = 0;
+    SDL_bool * results = (SDL_bool *) SDL_calloc(numTests, sizeof(SDL_bool));
+    if ( ! results) {
+        SDL_Log("%s, out of memory", __FUNCTION__);
+        for (uint8_t i = 0; i < PaddleCount; ++i) {
+            SDL_FreeSurface(paddleImages[i]);
+        }
+        SDL_free(balls);
+        GameStateDestroy(game);
+        SDL_free(game);
+        return 1;
+    }
+    for (uint8_t method = 0; method < 2; ++method) {
+        const uint64_t start = SDL_GetPerformanceCounter();
+        for (uint32_t i = 0; i < numTests; ++i) {
+            SDL_Rect intersection;
+            SDL_bool hit;
+            game->balls[0] = balls[i];
+            if (i % 2) {
+                hit = (method == 0) ?
+                    GameIsBallPowerupCollision(game, 0, 0, &intersection) :
+                    GameIsBallPowerupCollisionByPixels(game, 0, 0, &intersection);
+            } else {
+                const uint8_t paddleIndex = (i / 2) % PaddleCount;
+                hit = (method == 0) ?
+                    GameIsBallPaddleCollision(game, 0, paddleIndex) :
+                    GameIsBallPaddleCollisionByPixels(game, 0, paddleIndex, paddleImages[paddleIndex]);
+            }
+            if (hit) {
+                ++hits[method];
+            }
+            if (method == 0) {
+                results[i] = hit;
+            } else if (results[i] != hit) {
+                ++mismatches;
+            }
+        }
+        const uint64_t end = SDL_GetPerformanceCounter();
+        seconds[method] = (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+    }
+    
+    SDL_Log("  masks:  %.3f seconds (%.1f ns/test), %u hits", seconds[0], (seconds[0] * 1e9) / numTests, hits[0]);
+    SDL_Log("  pixels: %.3f seconds (%.1f ns/test), %u hits", seconds[1], (seconds[1] * 1e9) / numTests, hits[1]);
+    SDL_Log("  results: %s (%u of %u test(s) differ)", (mismatches == 0) ? "identical" : "DIFFERENT", mismatches, numTests);
+    
+    for (uint8_t i = 0; i < PaddleCount; ++i) {
+        SDL_FreeSurface(paddleImages[i]);
+    }
+    SDL_free(results);
+    SDL_free(balls);
+    GameStateDestroy(game);
+    SDL_free(game);
+    return (mismatches == 0) ? 0 : 1;
+}
+
+// AppRunSweepCheck -- fires fast balls (moving more than their radius per
+//   game-tick) at randomly-cut paddles, and checks that balls aimed at uncut
+//   rows bounce off of them, and that balls aimed through a gap pass through
+//   it without slowing down.  Even tests aim at uncut rows, odd ones at gaps.
+static int AppRunSweepCheck()
+{
+    const uint32_t numTests = AppCheckSweep;
+    GameState * game = (GameState *) SDL_calloc(1, sizeof(GameState));
+    if ( ! game || ! GameStateCreate(game, BallDefaultCapacity, PowerupDefaultCapacity)) {
+        SDL_Log("%s, out of memory", __FUNCTION__);
+        SDL_free(game);
+        return 1;
+    }
+    GameSeed(game, AppSeed);
+    Rand rand;
+    rand.Seed(AppSeed);
+    
+    SDL_Log("Firing %u fast balls at cut paddles, with seed %llu...", numTests, (unsigned long long)AppSeed);
+    uint32_t tests[2] = {0, 0};
+    uint32_t passes[2] = {0, 0};
+    for (uint32_t i = 0; i < numTests; ++i) {
+        const uint8_t throughGap = (uint8_t)(i % 2);
+        const uint8_t paddleIndex = (i / 2) % PaddleCount;
+        Paddle * paddle = &game->paddles[paddleIndex];
+        
+        // Start with just one ball, and no powerups, on the playfield
+        GameInit(game, GAME_INIT_DEFAULT);
+        for (uint16_t j = 0; j < game->ballCapacity; ++j) {
+            GameBallRemove(game, j);
+        }
+        for (uint16_t j = 0; j < game->powerupCapacity; ++j) {
+            game->powerups[j].type = PowerupType_Inactive;
+        }
+        
+        // Cut some random rows out of the paddle, plus, when aiming through a
+        // gap, a gap that the ball fits through
+        int16_t targetY = -1;
+        if (throughGap) {
+            const int16_t gapHeight = (int16_t) MathRandRangeI(&rand, BallSize + 8, BallSize + 30);
+            const int16_t gapTop = (int16_t) MathRandRangeI(&rand, 8, PaddleMaxH - 8 - gapHeight);
+            PaddleCut(paddle, paddleIndex, gapTop, gapTop + gapHeight);
+            targetY = gapTop + (gapHeight / 2);
+        }
+        for (uint8_t j = 0; j < 4; ++j) {
+            const int16_t top = (int16_t) MathRandRangeI(&rand, 0, PaddleMaxH - 1);
+            const int16_t height = (int16_t) MathRandRangeI(&rand, 1, 14);
+            PaddleCut(paddle, paddleIndex, top, SDL_min(top + height, PaddleMaxH));
+        }
+        
+        // When aiming at uncut rows, pick a row a few rows inside of a run of
+        // them, so that the ball reaches the paddle's face, not a corner
+        for (uint8_t attempt = 0; ( ! throughGap) && (attempt < 32) && (targetY < 0); ++attempt) {
+            const int16_t y = (int16_t) MathRandRangeI(&rand, paddle->cutTop + 2, paddle->cutBottom - 3);
+            int16_t uncutEnd;
+            if (paddle->FindUncutRows(y - 2, &uncutEnd) == (y - 2) && uncutEnd >= (y + 3)) {
+                targetY = y;
+            }
+        }
+        if (targetY < 0) {
+            continue;
+        }
+        
+        // Fire the ball from in front of the paddle, so that its center would
+        // cross the paddle's face at targetY
+        const int8_t direction = paddle->ballBounceDirection;
+        const Real faceX = (direction > 0) ? Real(paddle->Right()) : Real(paddle->Left());
+        const Real backX = (direction > 0) ? Real(paddle->Left()) : Real(paddle->Right());
+        const Real speed = MathRandRangeF(&rand, RealToFloat(BallRadius) + 1.f, 60.f);
+        const Real distance = MathRandRangeF(&rand, BallSize, 200.f);
+        Ball * ball = &game->balls[0];
+        GameBallSpawn(game, 0);
+        ball->type = BallTypeNoPlayer;
+        ball->vx = speed * Real(-direction);
+        ball->vy = throughGap ? Real(0.f) : (speed * MathRandRangeF(&rand, -0.25f, 0.25f));
+        ball->cx = faceX + ((distance + BallRadius) * Real(direction));
+        ball->cy = paddle->Top() + Real(targetY) - ((ball->vy * distance) / speed);
+        
+        // Balls that pass through should get behind the paddle as soon as a
+        // ball moving at full speed would.  Balls that bounce should do so by
+        // then, too, and in front of the paddle.
+        uint32_t ticks = 0;
+        for (Real x = ball->cx; ((x - backX) * Real(direction)) >= Real(0.f); x += ball->vx) {
+            ++ticks;
+        }
+        uint8_t healedPaddles = 0;
+        for (uint32_t tick = 0; tick < ticks; ++tick) {
+            GameUpdateBall(game, 0, SDL_FALSE, &healedPaddles);
+            if (ball->type == BallTypeInactive || ((ball->vx * Real(direction)) > Real(0.f))) {
+                break;
+            }
+        }
+        const SDL_bool behind = (SDL_bool)(ball->type == BallTypeInactive || ((ball->cx - backX) * Real(direction)) < Real(0.f));
+        const SDL_bool bounced = (SDL_bool)(( ! behind) && ((ball->vx * Real(direction)) > Real(0.f)));
+        ++tests[throughGap];
+        if (throughGap ? behind : bounced) {
+            ++passes[throughGap];
+        }
+    }
+    
+    SDL_Log("  aimed at uncut rows: %u of %u ball(s) bounced", passes[0], tests[0]);
+    SDL_Log("  aimed through gaps:  %u of %u ball(s) passed through", passes[1], tests[1]);
+    
+    GameStateDestroy(game);
+    SDL_free(game);
+    return (passes[0] == tests[0] && passes[1] == tests[1]) ? 0 : 1;
+}
+
+// AppRunTextBenchmark -- times drawing random strings, at random spots, in
+//   random colors, over random pixels, with TextBlendRow() against blending
+//   via the surface's format masks, and checks that both draw the same pixels
+static int AppRunTextBenchmark()
+{
+    struct BenchString {
+        char text[AppBenchTextMaxLength + 1];
+        int16_t x, y;
+        uint8_t r, g, b;
+    };
+    const uint32_t numStrings = AppBenchText;
+    BenchString * strings = (BenchString *) SDL_calloc(numStrings, sizeof(BenchString));
+    SDL_Surface * surfaces[2] = {
+        SDL_CreateRGBSurface(0, ScreenWidth, ScreenHeight, 32, ImageRMask, ImageGMask, ImageBMask, ImageAMask),
+        SDL_CreateRGBSurface(0, ScreenWidth, ScreenHeight, 32, ImageRMask, ImageGMask, ImageBMask, ImageAMask)
+    };
+    if ( ! strings || ! surfaces[0] || ! surfaces[1]) {
+        SDL_Log("%s, out of memory", __FUNCTION__);
+        SDL_FreeSurface(surfaces[0]);
+        SDL_FreeSurface(surfaces[1]);
+        SDL_free(strings);
+        return 1;
+    }
+    
+    // Start both surfaces from the same noise (alpha included), then make
+    // strings that stay on-screen
+    Rand rand;
+    rand.Seed(AppSeed);
+    for (int y = 0; y < ScreenHeight; ++y) {
+        uint32_t * row = (uint32_t *)((uint8_t *)surfaces[0]->pixels + (y * surfaces[0]->pitch));
+        for (int x = 0; x < ScreenWidth; ++x) {
+            row[x] = rand.Next();
+        }
+    }
+    SDL_memcpy(surfaces[1]->pixels, surfaces[0]->pixels, surfaces[0]->pitch * ScreenHeight);
+    uint64_t numChars = 0;
+    for (uint32_t i = 0; i < numStrings; ++i) {
+        const int length = MathRandRangeI(&rand, 1, AppBenchTextMaxLength);
+        for (int j = 0; j < length; ++j) {
+            strings[i].text[j] = (char) MathRandRangeI(&rand, FontFirstChar, FontFirstChar + FontCharCount - 1);
+        }
+        numChars += length;
+        strings[i].x = (int16_t) MathRandRangeI(&rand, 4, ScreenWidth - (AppBenchTextMaxLength * 24));
+        strings[i].y = (int16_t) MathRandRangeI(&rand, 4, ScreenHeight - 40);
+        strings[i].r = (uint8_t) MathRandRangeI(&rand, 0, 255);
+        strings[i].g = (uint8_t) MathRandRangeI(&rand, 0, 255);
+        strings[i].b = (uint8_t) MathRandRangeI(&rand, 0, 255);
+    }
+    
+    SDL_Log("Drawing %u strings (%llu characters), with seed %llu...", numStrings, (unsigned long long)numChars, (unsigned long long)AppSeed);
+    double seconds[2] = {0.0, 0.0};
+    SDL_Surface * screen = Screen;
+    for (uint8_t method = 0; method < 2; ++method) {
+        TextBlendUseKernel = (method == 0);
+        Screen = surfaces[method];
+        const uint64_t start = SDL_GetPerformanceCounter();
+        for (uint32_t i = 0; i < numStrings; ++i) {
+            TextDraw(FontIDHUDScores, strings[i].r, strings[i].g, strings[i].b, strings[i].x, strings[i].y, "%s", strings[i].text);
+        }
+        seconds[method] = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+    }
+    Screen = screen;
+    TextBlendUseKernel = 1;
+    
+    uint32_t mismatchedRows = 0;
+    for (int y = 0; y < ScreenHeight; ++y) {
+        if (SDL_memcmp((uint8_t *)surfaces[0]->pixels + (y * surfaces[0]->pitch),
+                       (uint8_t *)surfaces[1]->pixels + (y * surfaces[1]->pitch), ScreenWidth * 4) != 0)
+        {
+            ++mismatchedRows;
+        }
+    }
+    SDL_Log("  %s rows: %.3f seconds (%.1f ns/char)", TextBlendKernelName, seconds[0], (seconds[0] * 1e9) / SDL_max(numChars, 1ull));
+    SDL_Log("  format masks: %.3f seconds (%.1f ns/char) (%.2fx)", seconds[1], (seconds[1] * 1e9) / SDL_max(numChars, 1ull),
+            (seconds[0] > 0.0) ? (seconds[1] / seconds[0]) : 0.0);
+    SDL_Log("  results: %s (%u of %u row(s) differ)", (mismatchedRows == 0) ? "identical" : "DIFFERENT", mismatchedRows, (unsigned)ScreenHeight);
+    
+    SDL_FreeSurface(surfaces[0]);
+    SDL_FreeSurface(surfaces[1]);
+    SDL_free(strings);
+    return (mismatchedRows == 0) ? 0 : 1;
+}
+
+// AppRunStressTest -- runs a match with many balls + powerups, keeping every
+//   ball slot filled, and reports how long its game-ticks took
+static SDL_bool AppRunStressTest(GameState * game, uint16_t numBalls, SDL_bool usePowerupGrid, GameBallPool * ballPool, double * outSeconds, double * outAveragePowerups)
+{
+    if ( ! GameStateCreate(game, numBalls, AppStressPowerupCapacity)) {
+        return SDL_FALSE;
+    }
+    game->usePowerupGrid = usePowerupGrid;
+    game->ballPool = ballPool;
+    GameSeed(game, AppSeed);
+    GameInit(game, GAME_INIT_DEFAULT);
+    for (uint16_t i = 0; i < game->powerupCapacity; ++i) {
+        PowerupRespawn(game->powerups, game->powerupCapacity, i, &game->powerupSpots, &game->rand);
+    }
+    game->powerupGridIsStale = SDL_TRUE;
+    
+    uint64_t ticks = 0;
+    uint64_t powerupTicks = 0;
+    for (uint32_t tick = 0; tick < AppStressTicks; ++tick) {
+        // Top up the balls, outside of the timed part
+        for (uint16_t i = GameBallFindFree(game); i < game->ballCapacity; i = GameBallFindFree(game)) {
+            GameBallSpawn(game, i);
+        }
+        for (uint16_t i = 0; i < game->powerupCapacity; ++i) {
+            powerupTicks += (game->powerups[i].type != PowerupType_Inactive);
+        }
+        
+        const uint64_t start = SDL_GetPerformanceCounter();
+        GameUpdate(game, AppScriptedInput(0, tick));
+        ticks += SDL_GetPerformanceCounter() - start;
+    }
+    *outSeconds = (double)ticks / (double)SDL_GetPerformanceFrequency();
+    *outAveragePowerups = (double)powerupTicks / (double)SDL_max(AppStressTicks, 1u);
+    return SDL_TRUE;
+}
+
+// AppRunStressBenchmark -- times matches with 10 to 10,000 balls, both with
+//   and without the powerup grid (and, given '--threads N', with a
+//   GameBallPool), and checks that all give identical results
+static int AppRunStressBenchmark()
+{
+    SDL_Log("Running stress tests, %u game-ticks each, with up to %u powerups, with seed %llu...",
+            AppStressTicks, (unsigned)AppStressPowerupCapacity, (unsigned long long)AppSeed);
+    GameBallPool ballPool;
+    const SDL_bool usePool = (SDL_bool)(AppHeadlessThreads > 1);
+    uint16_t maxBalls = 0;
+    for (uint8_t i = 0; i < SDL_arraysize(AppStressBallCounts); ++i) {
+        maxBalls = SDL_max(maxBalls, AppStressBallCounts[i]);
+    }
+    if (usePool && ! GameBallPoolCreate(&ballPool, (uint8_t)SDL_min(AppHeadlessThreads, (uint32_t)GameBallPoolMaxThreads), maxBalls)) {
+        return 1;
+    }
+    int result = 0;
+    for (uint8_t i = 0; i < SDL_arraysize(AppStressBallCounts); ++i) {
+        const uint16_t numBalls = AppStressBallCounts[i];
+        GameState withGrid, withoutGrid;
+        double gridSeconds, bruteForceSeconds, averagePowerups;
+        if ( ! AppRunStressTest(&withGrid, numBalls, SDL_TRUE, NULL, &gridSeconds, &averagePowerups) ||
+            ! AppRunStressTest(&withoutGrid, numBalls, SDL_FALSE, NULL, &bruteForceSeconds, &averagePowerups))
+        {
+            result = 1;
+            break;
+        }
+        SDL_bool identical = GameStatesMatch(&withGrid, &withoutGrid);
+        SDL_Log("  %5u balls, %.1f powerups: grid %.3f ms/tick, every-powerup %.3f ms/tick (%.2fx), results %s",
+                (unsigned)numBalls, averagePowerups,
+                (gridSeconds * 1000.0) / SDL_max(AppStressTicks, 1u),
+                (bruteForceSeconds * 1000.0) / SDL_max(AppStressTicks, 1u),
+                (gridSeconds > 0.0) ? (bruteForceSeconds / gridSeconds) : 0.0,
+                identical ? "identical" : "DIFFERENT");
+        GameState withPool;
+        double poolSeconds;
+        if (usePool && AppRunStressTest(&withPool, numBalls, SDL_TRUE, &ballPool, &poolSeconds, &averagePowerups)) {
+            const SDL_bool poolIdentical = GameStatesMatch(&withGrid, &withPool);
+            SDL_Log("  %5u balls, %u threads: grid %.3f ms/tick (%.2fx), results %s%s",
+                    (unsigned)numBalls, (unsigned)ballPool.numThreads,
+                    (poolSeconds * 1000.0) / SDL_max(AppStressTicks, 1u),
+                    (poolSeconds > 0.0) ? (gridSeconds / poolSeconds) : 0.0,
+                    poolIdentical ? "identical" : "DIFFERENT",
+                    (numBalls < GameBallPoolMinBalls) ? " (balls updated serially)" : "");
+            identical = (SDL_bool)(identical && poolIdentical);
+            GameStateDestroy(&withPool);
+        } else if (usePool) {
+            identical = SDL_FALSE;
+        }
+        if ( ! identical) {
+            result = 1;
+        }
+        GameStateDestroy(&withGrid);
+        GameStateDestroy(&withoutGrid);
+    }
+    if (usePool) {
+        GameBallPoolDestroy(&ballPool);
+    }
+    return result;
+}
+
+// AppRunSnapshotBenchmark -- plays a scripted match, then restores its
+//   half-way snapshot into a second match, and replays the rest, rolling back
+//   and re-simulating every game-tick.  Reports save and restore speeds, and
+//   whether both matches ended up identical.
+static int AppRunSnapshotBenchmark()
+{
+    const uint32_t numTicks = AppSnapshotTicks;
+    GameState played;
+    GameState replayed;
+    GameSnapshot snapshot;
+    GameSnapshot halfway;
+    if ( ! GameStateCreate(&played, BallDefaultCapacity, PowerupDefaultCapacity)) {
+        return 1;
+    }
+    if ( ! GameStateCreate(&replayed, BallDefaultCapacity, PowerupDefaultCapacity)) {
+        GameStateDestroy(&played);
+        return 1;
+    }
+    GameSeed(&played, AppSeed);
+    GameInit(&played, GAME_INIT_DEFAULT);
+    GameSeed(&replayed, AppSeed);
+    GameInit(&replayed, GAME_INIT_DEFAULT);
+    
+    SDL_Log("Running %u game-ticks, with %u-byte snapshots, with seed %llu...",
+            numTicks, (unsigned)sizeof(GameSnapshot), (unsigned long long)AppSeed);
+    for (uint32_t i = 0; i < numTicks; ++i) {
+        if (i == numTicks / 2) {
+            GameSnapshotSave(&played, &halfway);
+        }
+        GameUpdate(&played, AppScriptedInput(0, i));
+    }
+    
+    GameSnapshotRestore(&replayed, &halfway);
+    for (uint32_t i = numTicks / 2; i < numTicks; ++i) {
+        const GameInput input = AppScriptedInput(0, i);
+        GameSnapshotSave(&replayed, &snapshot);
+        GameUpdate(&replayed, input);
+        GameSnapshotRestore(&replayed, &snapshot);
+        GameUpdate(&replayed, input);
+    }
+    const SDL_bool identical = GameStatesMatch(&played, &replayed);
+    
+    uint64_t start = SDL_GetPerformanceCounter();
+    for (uint32_t i = 0; i < numTicks; ++i) {
+        GameSnapshotSave(&played, &snapshot);
+    }
+    uint64_t end = SDL_GetPerformanceCounter();
+    const double saveSeconds = (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+    
+    start = SDL_GetPerformanceCounter();
+    for (uint32_t i = 0; i < numTicks; ++i) {
+        GameSnapshotRestore(&replayed, &halfway);
+    }
+    end = SDL_GetPerformanceCounter();
+    const double restoreSeconds = (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+    
+    SDL_Log("  save:    %.3f microseconds", (saveSeconds * 1000000.0) / SDL_max(numTicks, 1u));
+    SDL_Log("  restore: %.3f microseconds", (restoreSeconds * 1000000.0) / SDL_max(numTicks, 1u));
+    SDL_Log("  results: %s", identical ? "identical" : "DIFFERENT");
+    
+    GameStateDestroy(&played);
+    GameStateDestroy(&replayed);
+    return identical ? 0 : 1;
+}
+
+// AppRunReplayPlayback -- plays AppPlayback as fast as possible, then reports
+//   how fast it played, and whether it ended up the same as the recorded match
+static int AppRunReplayPlayback()
+{
+    GameState game;
+    if ( ! GameStateCreate(&game, BallDefaultCapacity, PowerupDefaultCapacity)) {
+        return 1;
+    }
+    SDL_Log("Playing %u game-ticks (%u input runs), headless, from %s...",
+            AppPlayback.tickCount, AppPlayback.runCount, AppPlayPath);
+    uint64_t start = SDL_GetPerformanceCounter();
+    SDL_bool matches = ReplayPlay(&AppPlayback, &game);
+    uint64_t end = SDL_GetPerformanceCounter();
+    const double seconds = (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+    const double playSeconds = (double)AppPlayback.tickCount / (double)TicksPerSecond;
+    SDL_Log("Played %.1f seconds of gameplay in %.3f ms (%.0fx real-time); scores: %u, %u; final state %s",
+            playSeconds, seconds * 1000.0, (seconds > 0.0) ? (playSeconds / seconds) : 0.0,
+            (unsigned)game.scores[0], (unsigned)game.scores[1],
+            matches ? "matches" : "DIFFERS");
+    
+    // Time seeks to random game-ticks.  Compare some against playing from
+    // the start, and the last against the recorded final state.
+    if (AppPlayback.tickCount > 0) {
+        GameState reference;
+        if ( ! GameStateCreate(&reference, BallDefaultCapacity, PowerupDefaultCapacity)) {
+            GameStateDestroy(&game);
+            return 1;
+        }
+        Rand rand;
+        rand.Seed(AppSeed);
+        ReplayPlayer player;
+        SDL_zero(player);
+        uint32_t mismatches = 0;
+        double seekSeconds = 0.0;
+        for (uint16_t i = 0; i < AppSeekTests; ++i) {
+            const uint32_t tick = (i == AppSeekTests - 1) ? AppPlayback.tickCount : (uint32_t)MathRandRangeI(&rand, 0, AppPlayback.tickCount - 1);
+            start = SDL_GetPerformanceCounter();
+            ReplaySeek(&AppPlayback, &game, &player, tick);
+            end = SDL_GetPerformanceCounter();
+            seekSeconds += (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+            if (i % 100 == 0) {
+                ReplayPlayer referencePlayer;
+                ReplayStart(&AppPlayback, &reference, &referencePlayer);
+                GameInput input;
+                while (referencePlayer.tick < tick && referencePlayer.Next(&input)) {
+                    GameUpdate(&reference, input);
+                }
+                if ( ! GameStatesMatch(&game, &reference)) {
+                    ++mismatches;
+                }
+            }
+        }
+        if (GameStateHash(&game) != AppPlayback.finalHash) {
+            ++mismatches;
+        }
+        SDL_Log("Seeked to %u random game-ticks, via %u keyframes, in %.3f ms each; results %s",
+                (unsigned)AppSeekTests, AppPlayback.keyframeCount,
+                (seekSeconds * 1000.0) / AppSeekTests,
+                (mismatches == 0) ? "identical" : "DIFFERENT");
+        matches = (matches && mismatches == 0) ? SDL_TRUE : SDL_FALSE;
+        GameStateDestroy(&reference);
+    }
+    GameStateDestroy(&game);
+    return matches ? 0 : 1;
+}
+
+// AppRunReplayRecording -- plays a match with scripted input (or the AI's, for
+//   AI-controlled paddles), for AppHeadlessTicks game-ticks, and records it
+//   to AppRecordPath
+static int AppRunReplayRecording()
+{
+    GameState game;
+    if ( ! GameStateCreate(&game, BallDefaultCapacity, PowerupDefaultCapacity)) {
+        return 1;
+    }
+    SDL_Log("Recording %u game-ticks, headless, with seed %llu, to %s...",
+            AppHeadlessTicks, (unsigned long long)AppSeed, AppRecordPath);
+    game.aiPaddles = AppAIPaddles;
+    GameSeed(&game, AppSeed);
+    GameInit(&game, GAME_INIT_DEFAULT);
+    for (uint32_t i = 0; i < AppHeadlessTicks; ++i) {
+        const GameInput input = GameInputFromAI(&game, AppScriptedInput(0, i));
+        if ( ! ReplayRecord(&AppRecording, input)) {
+            GameStateDestroy(&game);
+            return 1;
+        }
+        GameUpdate(&game, input);
+    }
+    ReplayFinish(&AppRecording, &game);
+    const SDL_bool saved = ReplaySave(&AppRecording, AppRecordPath);
+    if (saved) {
+        SDL_Log("Recorded %u input runs; scores: %u, %u",
+                AppRecording.runCount, (unsigned)game.scores[0], (unsigned)game.scores[1]);
+    }
+    GameStateDestroy(&game);
+    return saved ? 0 : 1;
+}
+
+// AppTournamentResult -- how one tournament match played out
+struct AppTournamentResult {
+    uint64_t seed;
+    uint32_t ticks;                         // length of the match, in game-ticks
+    uint16_t scores[PaddleCount];
+    uint32_t rounds;                        // number of rounds that ended in a score
+    uint32_t roundTicks;                    // total length of those rounds, in game-ticks
+    uint32_t shortestRound;                 // in game-ticks; 0 if no rounds ended
+    uint32_t longestRound;                  // in game-ticks
+    uint32_t powerupHits[PowerupType_LAST]; // as per GameState::powerupHits
+};
+
+// AppTournamentWorker -- one thread's share of a tournament.  Workers take
+//   whichever match is next, so that long matches don't leave threads idle.
+struct AppTournamentWorker {
+    SDL_atomic_t * nextMatch;       // index of the next match to play, shared by all workers
+    AppTournamentResult * results;  // one per match, in match order
+    uint32_t numMatches;
+    uint32_t matches;               // number of matches played by this worker
+    uint64_t ticks;                 // number of game-ticks run by this worker
+    double seconds;                 // time taken, as measured by the worker
+    SDL_bool failed;
+};
+
+// AppTournamentWorkerRun -- plays tournament matches, AI against AI, until none are left
+static int AppTournamentWorkerRun(void * data)
+{
+    AppTournamentWorker * worker = (AppTournamentWorker *) data;
+    const uint32_t maxTicks = TimingSecondsToTicks(AppTournamentMaxMatchTime);
+    const GameInput noInput = {0};
+    GameState game;
+    if ( ! GameStateCreate(&game, BallDefaultCapacity, PowerupDefaultCapacity)) {
+        worker->failed = SDL_TRUE;
+        return 1;
+    }
+    game.aiPaddles = (1 << PaddleCount) - 1;
+    
+    const uint64_t start = SDL_GetPerformanceCounter();
+    for (uint32_t m = (uint32_t) SDL_AtomicAdd(worker->nextMatch, 1);
+         m < worker->numMatches;
+         m = (uint32_t) SDL_AtomicAdd(worker->nextMatch, 1))
+    {
+        AppTournamentResult * result = &worker->results[m];
+        SDL_zerop(result);
+        result->seed = AppSeed + m;
+        GameStateReset(&game);
+        GameSeed(&game, result->seed);
+        GameInit(&game, GAME_INIT_DEFAULT);
+        
+        // Every point scored ends a round, which started with the match, or
+        // with the point before it (so rounds include the pause between
+        // them).  Points scored on the same game-tick end 0-tick rounds.
+        uint32_t tick = 0;
+        uint32_t roundStartedAt = 0;
+        uint32_t points = 0;
+        while (tick < maxTicks && game.scores[0] < AppTournamentWinningScore && game.scores[1] < AppTournamentWinningScore) {
+            GameUpdate(&game, GameInputFromAI(&game, noInput));
+            ++tick;
+            for (; points < (uint32_t)game.scores[0] + (uint32_t)game.scores[1]; ++points) {
+                const uint32_t length = tick - roundStartedAt;
+                result->shortestRound = (result->rounds == 0) ? length : SDL_min(result->shortestRound, length);
+                result->longestRound = SDL_max(result->longestRound, length);
+                result->roundTicks += length;
+                result->rounds++;
+                roundStartedAt = tick;
+            }
+        }
+        result->ticks = tick;
+        SDL_memcpy(result->scores, game.scores, sizeof(result->scores));
+        SDL_memcpy(result->powerupHits, game.powerupHits, sizeof(result->powerupHits));
+        worker->matches++;
+        worker->ticks += tick;
+    }
+    worker->seconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+    GameStateDestroy(&game);
+    return 0;
+}
+
+// AppTournamentSummary -- totals for a whole tournament
+struct AppTournamentSummary {
+    uint32_t wins[PaddleCount];
+    uint32_t draws;
+    uint32_t scoreCounts[PaddleCount][AppTournamentWinningScore + 1];  // number of matches ending with each score; the last one counts all higher scores, too
+    uint32_t scoreTotals[PaddleCount];
+    uint64_t ticks;
+    uint32_t shortestMatch;         // in game-ticks
+    uint32_t longestMatch;          // in game-ticks
+    uint32_t rounds;
+    uint64_t roundTicks;
+    uint32_t shortestRound;         // in game-ticks; 0 if no rounds ended
+    uint32_t longestRound;          // in game-ticks
+    uint64_t powerupHits[PowerupType_LAST];
+};
+
+// AppTournamentSummarize -- totals up all of a tournament's results
+static void AppTournamentSummarize(const AppTournamentResult * results, uint32_t numMatches, AppTournamentSummary * summary)
+{
+    SDL_zerop(summary);
+    for (uint32_t m = 0; m < numMatches; ++m) {
+        const AppTournamentResult * result = &results[m];
+        if (result->scores[0] == result->scores[1]) {
+            summary->draws++;
+        } else {
+            summary->wins[(result->scores[0] > result->scores[1]) ? 0 : 1]++;
+        }
+        for (uint8_t i = 0; i < PaddleCount; ++i) {
+            summary->scoreCounts[i][SDL_min(result->scores[i], AppTournamentWinningScore)]++;
+            summary->scoreTotals[i] += result->scores[i];
+        }
+        summary->shortestMatch = (m == 0) ? result->ticks : SDL_min(summary->shortestMatch, result->ticks);
+        summary->longestMatch = SDL_max(summary->longestMatch, result->ticks);
+        summary->ticks += result->ticks;
+        if (result->rounds > 0) {
+            summary->shortestRound = (summary->rounds == 0) ? result->shortestRound : SDL_min(summary->shortestRound, result->shortestRound);
+            summary->longestRound = SDL_max(summary->longestRound, result->longestRound);
+            summary->rounds += result->rounds;
+            summary->roundTicks += result->roundTicks;
+        }
+        for (uint8_t i = 0; i < PowerupType_LAST; ++i) {
+            summary->powerupHits[i] += result->powerupHits[i];
+        }
+    }
+}
+
+// AppReportPrint -- printf()s to a report file; SDL_FALSE if that failed
+static SDL_bool AppReportPrint(SDL_RWops * file, const char * format, ...)
+{
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    const int length = SDL_vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    return (length >= 0 && (size_t)length < sizeof(text) && SDL_RWwrite(file, text, length, 1) == 1) ? SDL_TRUE : SDL_FALSE;
+}
+
+// AppTournamentWriteReport -- writes a tournament's results to AppReportPath.
+//   JSON reports hold the summary, plus per-worker speeds.  CSV reports hold
+//   each match's result, which don't depend on the number of threads.
+static SDL_bool AppTournamentWriteReport(const AppTournamentResult * results, uint32_t numMatches,
+                                         const AppTournamentSummary * summary,
+                                         const AppTournamentWorker * workers, uint32_t numWorkers, double seconds)
+{
+    SDL_RWops * file = SDL_RWFromFile(AppReportPath, "wb");
+    if ( ! file) {
+        SDL_Log("%s, SDL_RWFromFile failed [%s]: %s", __FUNCTION__, AppReportPath, SDL_GetError());
+        return SDL_FALSE;
+    }
+    const size_t pathLength = SDL_strlen(AppReportPath);
+    const SDL_bool isJSON = (pathLength >= 5 && SDL_strcasecmp(AppReportPath + pathLength - 5, ".json") == 0) ? SDL_TRUE : SDL_FALSE;
+    const double tps = (double)TicksPerSecond;
+    SDL_bool ok = SDL_TRUE;
+    if (isJSON) {
+        ok = (ok &&
+              AppReportPrint(file, "{\n") &&
+              AppReportPrint(file, "  \"matches\": %u,\n  \"seed\": %llu,\n  \"tickRate\": %u,\n", numMatches, (unsigned long long)AppSeed, (unsigned)TicksPerSecond) &&
+              AppReportPrint(file, "  \"winningScore\": %u,\n  \"maxMatchSeconds\": %.1f,\n", (unsigned)AppTournamentWinningScore, AppTournamentMaxMatchTime) &&
+              AppReportPrint(file, "  \"seconds\": %.3f,\n  \"gameTicks\": %llu,\n  \"gameTicksPerSecond\": %.0f,\n",
+                             seconds, (unsigned long long)summary->ticks, (seconds > 0.0) ? ((double)summary->ticks / seconds) : 0.0) &&
+              AppReportPrint(file, "  \"workers\": [")) ? SDL_TRUE : SDL_FALSE;
+        for (uint32_t t = 0; ok && t < numWorkers; ++t) {
+            ok = AppReportPrint(file, "%s\n    {\"matches\": %u, \"gameTicks\": %llu, \"seconds\": %.3f, \"gameTicksPerSecond\": %.0f}",
+                                (t > 0) ? "," : "", workers[t].matches, (unsigned long long)workers[t].ticks, workers[t].seconds,
+                                (workers[t].seconds > 0.0) ? ((double)workers[t].ticks / workers[t].seconds) : 0.0);
+        }
+        ok = (ok &&
+              AppReportPrint(file, "\n  ],\n  \"wins\": {\"left\": %u, \"right\": %u, \"draws\": %u},\n",
+                             summary->wins[0], summary->wins[1], summary->draws) &&
+              AppReportPrint(file, "  \"scores\": {")) ? SDL_TRUE : SDL_FALSE;
+        for (uint8_t i = 0; ok && i < PaddleCount; ++i) {
+            ok = AppReportPrint(file, "%s\n    \"%s\": {\"mean\": %.3f, \"counts\": [", (i > 0) ? "," : "", (i == 0) ? "left" : "right",
+                                (double)summary->scoreTotals[i] / (double)numMatches);
+            for (uint16_t score = 0; ok && score <= AppTournamentWinningScore; ++score) {
+                ok = AppReportPrint(file, "%s%u", (score > 0) ? ", " : "", summary->scoreCounts[i][score]);
+            }
+            ok = (ok && AppReportPrint(file, "]}")) ? SDL_TRUE : SDL_FALSE;
+        }
+        ok = (ok &&
+              AppReportPrint(file, "\n  },\n  \"matchSeconds\": {\"mean\": %.3f, \"min\": %.3f, \"max\": %.3f},\n",
+                             ((double)summary->ticks / (double)numMatches) / tps, summary->shortestMatch / tps, summary->longestMatch / tps) &&
+              AppReportPrint(file, "  \"rounds\": {\"count\": %u, \"meanSeconds\": %.3f, \"minSeconds\": %.3f, \"maxSeconds\": %.3f},\n",
+                             summary->rounds, (summary->rounds > 0) ? (((double)summary->roundTicks / (double)summary->rounds) / tps) : 0.0,
+                             summary->shortestRound / tps, summary->longestRound / tps) &&
+              AppReportPrint(file, "  \"powerupHitsPerMinute\": {")) ? SDL_TRUE : SDL_FALSE;
+        for (uint8_t i = 1; ok && i < PowerupType_LAST; ++i) {
+            ok = AppReportPrint(file, "%s\"%s\": %.3f", (i > 1) ? ", " : "", PowerupTypeNames[i],
+                                (summary->ticks > 0) ? ((double)summary->powerupHits[i] / ((double)summary->ticks / (tps * 60.0))) : 0.0);
+        }
+        ok = (ok && AppReportPrint(file, "}\n}\n")) ? SDL_TRUE : SDL_FALSE;
+    } else {
+        ok = AppReportPrint(file, "match,seed,ticks,leftScore,rightScore,rounds,roundTicks,shortestRound,longestRound");
+        for (uint8_t i = 1; ok && i < PowerupType_LAST; ++i) {
+            ok = AppReportPrint(file, ",%sHits", PowerupTypeNames[i]);
+        }
+        ok = (ok && AppReportPrint(file, "\n")) ? SDL_TRUE : SDL_FALSE;
+        for (uint32_t m = 0; ok && m < numMatches; ++m) {
+            const AppTournamentResult * result = &results[m];
+            ok = AppReportPrint(file, "%u,%llu,%u,%u,%u,%u,%u,%u,%u", m, (unsigned long long)result->seed, result->ticks,
+                                (unsigned)result->scores[0], (unsigned)result->scores[1],
+                                result->rounds, result->roundTicks, result->shortestRound, result->longestRound);
+            for (uint8_t i = 1; ok && i < PowerupType_LAST; ++i) {
+                ok = AppReportPrint(file, ",%u", result->powerupHits[i]);
+            }
+            ok = (ok && AppReportPrint(file, "\n")) ? SDL_TRUE : SDL_FALSE;
+        }
+    }
+    if (SDL_RWclose(file) != 0) {
+        ok = SDL_FALSE;
+    }
+    if ( ! ok) {
+        SDL_Log("%s, couldn't write report [%s]: %s", __FUNCTION__, AppReportPath, SDL_GetError());
+    }
+    return ok;
+}
+
+// AppRunTournament -- plays AppTournamentMatches bot-vs-bot matches, spread
+//   across threads, then reports how they went, and how fast they ran.
+//   Match N is seeded with (AppSeed + N), whichever thread plays it.
+static int AppRunTournament()
+{
+    const uint32_t numMatches = AppTournamentMatches;
+    const uint32_t numThreads = SDL_min(AppHeadlessThreads ? AppHeadlessThreads : (uint32_t)SDL_GetCPUCount(), numMatches);
+    AppTournamentResult * results = (AppTournamentResult *) SDL_calloc(numMatches, sizeof(AppTournamentResult));
+    AppTournamentWorker * workers = (AppTournamentWorker *) SDL_calloc(numThreads, sizeof(AppTournamentWorker));
+    SDL_Thread ** threads = (SDL_Thread **) SDL_calloc(numThreads, sizeof(SDL_Thread *));
+    if ( ! results || ! workers || ! threads) {
+        SDL_Log("%s, out of memory", __FUNCTION__);
+        SDL_free(threads);
+        SDL_free(workers);
+        SDL_free(results);
+        return 1;
+    }
+    
+    SDL_Log("Running a tournament of %u bot-vs-bot matches (to %u points, or %.0f seconds), on %u thread(s), with seed %llu...",
+            numMatches, (unsigned)AppTournamentWinningScore, AppTournamentMaxMatchTime, numThreads, (unsigned long long)AppSeed);
+    SDL_atomic_t nextMatch;
+    SDL_AtomicSet(&nextMatch, 0);
+    const uint64_t start = SDL_GetPerformanceCounter();
+    for (uint32_t t = 0; t < numThreads; ++t) {
+        workers[t].nextMatch = &nextMatch;
+        workers[t].results = results;
+        workers[t].numMatches = numMatches;
+        if (t == 0) {
+            continue;   // the calling thread will run worker 0, once all others have started
+        }
+        threads[t] = SDL_CreateThread(AppTournamentWorkerRun, "TournamentWorker", &workers[t]);
+        if ( ! threads[t]) {
+            SDL_Log("%s, SDL_CreateThread failed: %s", __FUNCTION__, SDL_GetError());
+        }
+    }
+    AppTournamentWorkerRun(&workers[0]);
+    SDL_bool failed = workers[0].failed;
+    for (uint32_t t = 1; t < numThreads; ++t) {
+        if (threads[t]) {
+            SDL_WaitThread(threads[t], NULL);
+        }
+        failed = (failed || workers[t].failed) ? SDL_TRUE : SDL_FALSE;
+    }
+    const double seconds = (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+    if (failed || (uint32_t)SDL_AtomicGet(&nextMatch) < numMatches) {
+        SDL_Log("%s, not all matches could be played", __FUNCTION__);
+        SDL_free(threads);
+        SDL_free(workers);
+        SDL_free(results);
+        return 1;
+    }
+    
+    AppTournamentSummary summary;
+    AppTournamentSummarize(results, numMatches, &summary);
+    const double tps = (double)TicksPerSecond;
+    for (uint32_t t = 0; t < numThreads; ++t) {
+        SDL_Log("  thread %u: %u match(es), %llu game-ticks in %.3f seconds (%.0f ticks/sec)",
+                t, workers[t].matches, (unsigned long long)workers[t].ticks, workers[t].seconds,
+                (workers[t].seconds > 0.0) ? ((double)workers[t].ticks / workers[t].seconds) : 0.0);
+    }
+    SDL_Log("Ran %llu game-ticks in %.3f seconds (%.0f ticks/sec)",
+            (unsigned long long)summary.ticks, seconds, (seconds > 0.0) ? ((double)summary.ticks / seconds) : 0.0);
+    SDL_Log("  wins: left %u, right %u, draws %u", summary.wins[0], summary.wins[1], summary.draws);
+    SDL_Log("  mean scores: left %.2f, right %.2f",
+            (double)summary.scoreTotals[0] / (double)numMatches, (double)summary.scoreTotals[1] / (double)numMatches);
+    SDL_Log("  matches: %.1f seconds, on average (%.1f to %.1f)",
+            ((double)summary.ticks / (double)numMatches) / tps, summary.shortestMatch / tps, summary.longestMatch / tps);
+    SDL_Log("  rounds: %u, %.2f seconds, on average (%.2f to %.2f)", summary.rounds,
+            (summary.rounds > 0) ? (((double)summary.roundTicks / (double)summary.rounds) / tps) : 0.0,
+            summary.shortestRound / tps, summary.longestRound / tps);
+    for (uint8_t i = 1; i < PowerupType_LAST; ++i) {
+        SDL_Log("  %s powerup hits: %llu (%.2f per minute)", PowerupTypeNames[i], (unsigned long long)summary.powerupHits[i],
+                (summary.ticks > 0) ? ((double)summary.powerupHits[i] / ((double)summary.ticks / (tps * 60.0))) : 0.0);
+    }
+    
+    const SDL_bool reported = ( ! AppReportPath || AppTournamentWriteReport(results, numMatches, &summary, workers, numThreads, seconds)) ? SDL_TRUE : SDL_FALSE;
+    SDL_free(threads);
+    SDL_free(workers);
+    SDL_free(results);
+    return reported ? 0 : 1;
+}
+
+// AppRunHeadless -- runs game-ticks, back-to-back, then reports how fast they ran.
+//   Useful for load-testing, AI training, and regression runs, on machines without a display.
+//   Each match N is seeded with (AppSeed + N), and matches are split evenly across threads.
+static int AppRunHeadless()
+{
+    if (AppBenchCollisions) {
+        return AppRunCollisionBenchmark();
+    }
+    if (AppCheckSweep) {
+        return AppRunSweepCheck();
+    }
+    if (AppBenchText) {
+        return AppRunTextBenchmark();
+    }
+    if (AppStressTicks) {
+        return AppRunStressBenchmark();
+    }
+    if (AppSnapshotTicks) {
+        return AppRunSnapshotBenchmark();
+    }
+    if (AppTournamentMatches) {
+        return AppRunTournament();
+    }
+    if (AppPlayPath) {
+        return AppRunReplayPlayback();
+    }
+    if (AppRecordPath) {
+        return AppRunReplayRecording();
+    }
+    
+    const uint32_t numMatches = SDL_max(AppHeadlessMatches, 1u);
+    const uint32_t numThreads = SDL_min(SDL_max(AppHeadlessThreads, 1u), numMatches);
+    GameState * games = (GameState *) SDL_calloc(numMatches, sizeof(GameState));
+    AppHeadlessWorker * workers = (AppHeadlessWorker *) SDL_calloc(numThreads, sizeof(AppHeadlessWorker));
+    SDL_Thread ** threads = (SDL_Thread **) SDL_calloc(numThreads, sizeof(SDL_Thread *));
+    if ( ! games || ! workers || ! threads) {
+        SDL_Log("%s, out of memory", __FUNCTION__);
+        SDL_free(threads);
+        SDL_free(workers);
+        SDL_free(games);
+        return 1;
+    }
+    for (uint32_t m = 0; m < numMatches; ++m) {
+        if ( ! GameStateCreate(&games[m], BallDefaultCapacity, PowerupDefaultCapacity)) {
+            for (uint32_t i = 0; i < m; ++i) {
+                GameStateDestroy(&games[i]);
+            }
+            SDL_free(threads);
+            SDL_free(workers);
+            SDL_free(games);
+            return 1;
+        }
+        games[m].aiPaddles = AppAIPaddles;
+        GameSeed(&games[m], AppSeed + m);
+        GameInit(&games[m], GAME_INIT_DEFAULT);
+    }
+    
+    SDL_Log("Running %u game-ticks, for %u match(es), on %u thread(s), headless, with seed %llu%s...",
+            AppHeadlessTicks, numMatches, numThreads, (unsigned long long)AppSeed,
+            AppAIPaddles ? ", with AI paddle(s)" : "");
+    const uint64_t start = SDL_GetPerformanceCounter();
+    uint32_t firstMatch = 0;
+    for (uint32_t t = 0; t < numThreads; ++t) {
+        workers[t].games = &games[firstMatch];
+        workers[t].count = (numMatches / numThreads) + ((t < (numMatches % numThreads)) ? 1 : 0);
+        firstMatch += workers[t].count;
+        if (t == 0) {
+            continue;   // the calling thread will run worker 0, once all others have started
+        }
+        threads[t] = SDL_CreateThread(AppHeadlessWorkerRun, "HeadlessWorker", &workers[t]);
+        if ( ! threads[t]) {
+            SDL_Log("%s, SDL_CreateThread failed: %s", __FUNCTION__, SDL_GetError());
+            AppHeadlessWorkerRun(&workers[t]);
+        }
+    }
+    AppHeadlessWorkerRun(&workers[0]);
+    for (uint32_t t = 1; t < numThreads; ++t) {
+        if (threads[t]) {
+            SDL_WaitThread(threads[t], NULL);
+        }
+    }
+    const uint64_t end = SDL_GetPerformanceCounter();
+    
+    const double seconds = (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+    const double totalTicks = (double)AppHeadlessTicks * (double)numMatches;
+    for (uint32_t t = 0; t < numThreads; ++t) {
+        SDL_Log("  thread %u: %u match(es) in %.3f seconds (%.0f ticks/sec)",
+                t,
+                workers[t].count,
+                workers[t].seconds,
+                (workers[t].seconds > 0.0) ? (((double)AppHeadlessTicks * workers[t].count) / workers[t].seconds) : 0.0);
+    }
+    SDL_Log("Ran %.0f game-ticks in %.3f seconds (%.0f ticks/sec); match 0 scores: %u, %u",
+            totalTicks,
+            seconds,
+            (seconds > 0.0) ? (totalTicks / seconds) : 0.0,
+            games[0].scores[0],
+            games[0].scores[1]);
+    
+    for (uint32_t m = 0; m < numMatches; ++m) {
+        GameStateDestroy(&games[m]);
+    }
+    SDL_free(threads);
+    SDL_free(workers);
+    SDL_free(games);
+    return 0;
+}
+
 int main(int argc, char * argv[])
 {
+    // Parse command-line options
+    for (int i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "--headless") == 0) {
+            AppHeadless = 1;
+            if (((i + 1) < argc) && SDL_isdigit(argv[i + 1][0])) {
+                AppHeadlessTicks = (uint32_t) SDL_strtoul(argv[++i], NULL, 10);
+            }
+        } else if ((SDL_strcmp(argv[i], "--seed") == 0) && ((i + 1) < argc)) {
+            AppSeed = SDL_strtoull(argv[++i], NULL, 10);
+            AppSeedGiven = 1;
+        } else if ((SDL_strcmp(argv[i], "--matches") == 0) && ((i + 1) < argc)) {
+            AppHeadlessMatches = (uint32_t) SDL_strtoul(argv[++i], NULL, 10);
+        } else if ((SDL_strcmp(argv[i], "--threads") == 0) && ((i + 1) < argc)) {
+            AppHeadlessThreads = (uint32_t) SDL_strtoul(argv[++i], NULL, 10);
+        } else if (SDL_strcmp(argv[i], "--bench-collisions") == 0) {
+            AppHeadless = 1;
+            AppBenchCollisions = 1000000;
+            if (((i + 1) < argc) && SDL_isdigit(argv[i + 1][0])) {
+                AppBenchCollisions = (uint32_t) SDL_strtoul(argv[++i], NULL, 10);
+            }
+        } else if (SDL_strcmp(argv[i], "--check-sweep") == 0) {
+            AppHeadless = 1;
+            AppCheckSweep = 10000;
+            if (((i + 1) < argc) && SDL_isdigit(argv[i + 1][0])) {
+                AppCheckSweep = (uint32_t) SDL_strtoul(argv[++i], NULL, 10);
+            }
+        } else if (SDL_strcmp(argv[i], "--bench-text") == 0) {
+            AppHeadless = 1;
+            AppBenchText = 100000;
+            if (((i + 1) < argc) && SDL_isdigit(argv[i + 1][0])) {
+                AppBenchText = (uint32_t) SDL_strtoul(argv[++i], NULL, 10);
+            }
+        } else if ((SDL_strcmp(argv[i], "--tick-rate") == 0) && ((i + 1) < argc)) {
+            const unsigned long rate = SDL_strtoul(argv[++i], NULL, 10);
+            TicksPerSecond = (uint16_t) SDL_max(TicksPerSecondMin, SDL_min(TicksPerSecondMax, rate));
+        } else if (SDL_strcmp(argv[i], "--bench-snapshots") == 0) {
+            AppHeadless = 1;
+            AppSnapshotTicks = 100000;
+            if (((i + 1) < argc) && SDL_isdigit(argv[i + 1][0])) {
+                AppSnapshotTicks = (uint32_t) SDL_strtoul(argv[++i], NULL, 10);
+            }
+        } else if ((SDL_strcmp(argv[i], "--record") == 0) && ((i + 1) < argc)) {
+            AppRecordPath = argv[++i];
+        } else if ((SDL_strcmp(argv[i], "--play") == 0) && ((i + 1) < argc)) {
+            AppPlayPath = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--no-frame-skip") == 0) {
+            AppFrameSkip = 0;
+        } else if (SDL_strcmp(argv[i], "--lock-texture") == 0) {
+            AppDrawIntoTexture = 1;
+        } else if (SDL_strcmp(argv[i], "--tournament") == 0) {
+            AppHeadless = 1;
+            AppTournamentMatches = 1000;
+            if (((i + 1) < argc) && SDL_isdigit(argv[i + 1][0])) {
+                AppTournamentMatches = (uint32_t) SDL_strtoul(argv[++i], NULL, 10);
+            }
+        } else if ((SDL_strcmp(argv[i], "--report") == 0) && ((i + 1) < argc)) {
+            AppReportPath = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--ai") == 0) {
+            AppAIPaddles = (1 << PaddleCount) - 1;
+            if (((i + 1) < argc) && SDL_strcmp(argv[i + 1], "left") == 0) {
+                AppAIPaddles = (1 << 0);
+                ++i;
+            } else if (((i + 1) < argc) && SDL_strcmp(argv[i + 1], "right") == 0) {
+                AppAIPaddles = (1 << 1);
+                ++i;
+            } else if (((i + 1) < argc) && SDL_strcmp(argv[i + 1], "both") == 0) {
+                ++i;
+            }
+        } else if (SDL_strcmp(argv[i], "--stress") == 0) {
+            AppHeadless = 1;
+            AppStressTicks = 1000;
+            if (((i + 1) < argc) && SDL_isdigit(argv[i + 1][0])) {
+                AppStressTicks = (uint32_t) SDL_strtoul(argv[++i], NULL, 10);
+            }
+        }
+    }
+    if ( ! AppSeedGiven) {
+        AppSeed = (uint64_t) time(0);
+    }
+    
+    // Replays get played at the rate they were recorded at
+    if (AppPlayPath) {
+        if ( ! ReplayLoad(&AppPlayback, AppPlayPath)) {
+            return 1;
+        }
+        TicksPerSecond = AppPlayback.ticksPerSecond;
+        AppSeed = AppPlayback.seed;
+    }
+    if (AppRecordPath) {
+        ReplayBegin(&AppRecording, AppSeed);
+    }
+    
     // Init SDL, and other low-level systems
-    if (AppInit() != 0) {
+    if ((AppHeadless ? AppInitHeadless() : AppInit()) != 0) {
         return 1;
     }
 
@@ -1672,13 +5258,34 @@ int main(int argc, char * argv[])
         return 1;
     }
 
+    // Replays need keyframes, for seeking
+    if (AppPlayPath && ! AppPlaybackIndex()) {
+        return 1;
+    }
+
+    // Run without a window?
+    if (AppHeadless) {
+        return AppRunHeadless();
+    }
+
     // Make sure a (fixed frame-rate) game-update occurs on the first AppUpdate() call
     NextGameTickAt = 0;
+    NextGameTickRemainder = 0;
+    SDL_zero(Governor);
 
     // Start a new round of gameplay
+    if ( ! GameStateCreate(&Game, BallDefaultCapacity, PowerupDefaultCapacity)) {
+        return 1;
+    }
+    Game.aiPaddles = AppAIPaddles;
     // TODO: Call GameInit() more frequently, to restart game.
     // NOTE: 'R' debug key will invoke GameInit(), which will forcefully restart the game!
-    GameInit(GAME_INIT_DEFAULT);
+    if (AppPlayPath) {
+        ReplayStart(&AppPlayback, &Game, &AppPlaybackPlayer);
+    } else {
+        GameSeed(&Game, AppSeed);
+        GameInit(&Game, GAME_INIT_DEFAULT);
+    }
 
     // Game loop
 #ifdef __EMSCRIPTEN__
@@ -1689,6 +5296,20 @@ int main(int argc, char * argv[])
     }
 #endif
     
+    if (Governor.droppedTicks > 0 || Governor.skippedFrames > 0) {
+        SDL_Log("Fell behind: dropped %llu game-tick(s), skipped %llu frame(s)",
+                (unsigned long long)Governor.droppedTicks,
+                (unsigned long long)Governor.skippedFrames);
+    }
+    
+    if (AppRecordPath) {
+        ReplayFinish(&AppRecording, &Game);
+        if ( ! ReplaySave(&AppRecording, AppRecordPath)) {
+            return 1;
+        }
+        SDL_Log("Recorded %u game-ticks, to %s", AppRecording.tickCount, AppRecordPath);
+    }
+    
     return 0;
 }
 